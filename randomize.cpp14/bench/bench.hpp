@@ -0,0 +1,111 @@
+/**
+ * Shared by the benchmarks: the time per operation of a loop, best of a
+ * few runs, and the percentiles of latency samples. The first argument
+ * of a benchmark scales its iteration counts, e.g. 0.1 for a quick run.
+ */
+
+#ifndef bench_h
+#define bench_h
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+namespace bench {
+    /**
+     * Keep a result alive, so that the loop computing it is not
+     * optimized out.
+     */
+    template <typename T>
+    void keep(T value) {
+        static volatile T sink;
+        sink = value;
+        static_cast<void>(sink);
+    }
+    
+    /**
+     * @return - the scale given as first argument, 1 by default.
+     */
+    inline double scale(int argc, char** argv) {
+        const auto value = argc > 1 ? std::atof(argv[1]) : 1.0;
+        return value > 0 ? value : 1.0;
+    }
+    
+    /**
+     * @return - count scaled, at least 1.
+     */
+    inline std::size_t scaled(double scale, std::size_t count) {
+        const auto n = static_cast<std::size_t>(scale * static_cast<double>(count));
+        return n != 0 ? n : 1;
+    }
+    
+    /**
+     * Run f, which performs operations operations, a few times.
+     * @return - the best time, in ns per operation.
+     */
+    template <typename F>
+    double ns_per_op(std::size_t operations, F f, int runs = 5) {
+        auto best = 1e300;
+        for (int run = 0; run < runs; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / static_cast<double>(operations));
+        }
+        return best;
+    }
+    
+    /**
+     * Timestamp of the latency samples: the time stamp counter on x86,
+     * in cycles, and the steady clock elsewhere, in ns.
+     */
+    inline std::uint64_t ticks() {
+        #if defined(__x86_64__) || defined(__i386__)
+            _mm_lfence();
+            const auto t = __rdtsc();
+            _mm_lfence();
+            return t;
+        #else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        #endif
+    }
+    
+    /**
+     * @return - the cost of two back to back ticks(), subtracted from
+     * the samples.
+     */
+    inline std::uint64_t ticks_overhead() {
+        auto overhead = ~std::uint64_t{0};
+        for (int i = 0; i < 100000; ++i) {
+            const auto a = ticks();
+            const auto b = ticks();
+            overhead = std::min(overhead, b - a);
+        }
+        return overhead;
+    }
+    
+    /**
+     * Print the p50, p99, p99.9 and p99.99 of the samples.
+     */
+    inline void print_percentiles(const char* name, std::vector<std::uint64_t> samples) {
+        if (samples.empty()) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        const auto at = [&samples](double p) {
+            return static_cast<unsigned long long>(samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))]);
+        };
+        std::printf("%-32s p50 %6llu  p99 %6llu  p99.9 %7llu  p99.99 %7llu\n", name, at(0.5), at(0.99), at(0.999), at(0.9999));
+    }
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Latency of each draw of rand(1, 6), by requests of 16 draws, with an
+// engine, the same engine buffered, and the buffer topped up by refill()
+// between two requests, in ticks (cycles on x86).
+// g++ -std=c++14 -O2 -I.. buffered_latency_bench.cpp -pthread
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    
+    template <typename Engine>
+    void run(const std::string& name, std::size_t requests, bool refill_between, std::uint64_t overhead) {
+        std::vector<std::uint64_t> samples;
+        samples.reserve(16 * requests);
+        long long sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            for (int d = 0; d < 16; ++d) {
+                const auto before = bench::ticks();
+                sum += rand<int, Engine>(1, 6);
+                samples.push_back(bench::ticks() - before - overhead);
+            }
+            if (refill_between) {
+                refill<Engine>();
+            }
+        }
+        bench::keep(sum);
+        bench::print_percentiles(name.c_str(), std::move(samples));
+    }
+    
+    template <typename Engine>
+    void engine(const char* name, std::size_t requests, std::uint64_t overhead) {
+        run<Engine>(name, requests, false, overhead);
+        run<engines::buffered<Engine>>(std::string{"buffered "} + name, requests, false, overhead);
+        run<engines::buffered<Engine>>(std::string{"buffered "} + name + " + refill", requests, true, overhead);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto requests = bench::scaled(bench::scale(argc, argv), 1000000);
+    const auto overhead = bench::ticks_overhead();
+    engine<std::mt19937_64>("mt19937_64", requests, overhead);
+    engine<engines::xoshiro256starstar>("xoshiro256**", requests, overhead);
+}
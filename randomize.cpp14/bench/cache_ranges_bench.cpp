@@ -0,0 +1,78 @@
+// get_rand with up to 10^6 distinct float and integer ranges: the time
+// per call when each range is new, then when the ranges come back in
+// another order, with the hit rate of the cache, which holds
+// RANDOMIZE_GET_RAND_CAPACITY entries per type.
+// g++ -std=c++14 -O2 -I.. cache_ranges_bench.cpp -pthread
+
+#include <chrono>
+#include <cstdio>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    template <typename F>
+    double ns_per_call(int calls, F f) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / calls;
+    }
+    
+    /**
+     * @return - the ratio of hits since the previous statistics.
+     */
+    template <typename T>
+    double hit_rate(randomize::cache_statistics& previous) {
+        const auto current = randomize::get_rand_statistics<T>();
+        const auto hits = current.hits - previous.hits;
+        const auto misses = current.misses - previous.misses;
+        previous = current;
+        return static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+    
+    void run(int ranges) {
+        auto floats = randomize::get_rand_statistics<float>();
+        auto ints = randomize::get_rand_statistics<int>();
+        double sum = 0;
+        // Float ranges all inside the unit interval
+        const auto float_insert = ns_per_call(ranges, [&] {
+            for (int i = 0; i < ranges; ++i) {
+                const auto min = static_cast<float>(i) / static_cast<float>(ranges);
+                sum += randomize::get_rand(min, min + 1e-3f)();
+            }
+        });
+        hit_rate<float>(floats);
+        const auto float_lookup = ns_per_call(ranges, [&] {
+            for (int i = 0; i < ranges; ++i) {
+                const auto j = static_cast<int>(i * 7919LL % ranges);
+                const auto min = static_cast<float>(j) / static_cast<float>(ranges);
+                sum += randomize::get_rand(min, min + 1e-3f)();
+            }
+        });
+        const auto float_hits = hit_rate<float>(floats);
+        const auto int_insert = ns_per_call(ranges, [&] {
+            for (int i = 0; i < ranges; ++i) {
+                sum += randomize::get_rand(i, 2 * i + 7)();
+            }
+        });
+        hit_rate<int>(ints);
+        const auto int_lookup = ns_per_call(ranges, [&] {
+            for (int i = 0; i < ranges; ++i) {
+                const auto j = static_cast<int>(i * 7919LL % ranges);
+                sum += randomize::get_rand(j, 2 * j + 7)();
+            }
+        });
+        const auto int_hits = hit_rate<int>(ints);
+        bench::keep(sum);
+        std::printf("%8d ranges  float: new %6.1f  again %6.1f ns (%3.0f%% hits)  int: new %6.1f  again %6.1f ns (%3.0f%% hits)\n",
+                    ranges, float_insert, float_lookup, 100 * float_hits, int_insert, int_lookup, 100 * int_hits);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto scale = bench::scale(argc, argv);
+    for (int ranges : {1000, 10000, 60000, 1000000}) {
+        run(static_cast<int>(bench::scaled(scale, static_cast<std::size_t>(ranges))));
+    }
+}
@@ -0,0 +1,69 @@
+// get_rand called by 1, 8 and 64 threads, on ranges shared by all the
+// threads or disjoint ones, i.e. cache hits on the same or different
+// entries: throughput, and latency percentiles of each call with its
+// draw, in ticks (cycles on x86).
+// g++ -std=c++14 -O2 -I.. cache_threads_bench.cpp -pthread
+
+#define RANDOMIZE_THREAD_LOCAL_ENGINES
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    void run(unsigned threads, bool disjoint, int ranges, std::size_t calls, std::uint64_t overhead) {
+        std::vector<std::vector<std::uint64_t>> latencies(threads);
+        std::atomic<unsigned> ready{0};
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                auto& samples = latencies[t];
+                samples.reserve(calls);
+                ++ready;
+                while (ready < threads) {
+                    std::this_thread::yield();
+                }
+                long long sum = 0;
+                for (std::size_t i = 0; i < calls; ++i) {
+                    const auto r = static_cast<int>(i % static_cast<std::size_t>(ranges));
+                    const auto min = disjoint ? static_cast<int>(t) * ranges + r : r;
+                    const auto before = bench::ticks();
+                    sum += randomize::get_rand(min, min + 1000)();
+                    samples.push_back(bench::ticks() - before - overhead);
+                }
+                bench::keep(sum);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        
+        std::vector<std::uint64_t> all;
+        for (auto& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        char name[64];
+        std::snprintf(name, sizeof name, "%2u threads, %-8s %4d %6.2f M/s", threads, disjoint ? "disjoint" : "shared",
+                      ranges, static_cast<double>(all.size()) / elapsed.count() / 1e6);
+        bench::print_percentiles(name, std::move(all));
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto calls = bench::scaled(bench::scale(argc, argv), 20000);
+    const auto overhead = bench::ticks_overhead();
+    for (unsigned threads : {1, 8, 64}) {
+        for (bool disjoint : {false, true}) {
+            for (int ranges : {8, 1000}) {
+                run(threads, disjoint, ranges, calls, overhead);
+            }
+        }
+    }
+}
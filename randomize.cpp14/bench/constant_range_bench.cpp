@@ -0,0 +1,40 @@
+// rand<T, min, max> with constant ranges, whose reduction is computed at
+// compile time, against the same ranges given at runtime, in ns per draw.
+// The power of two ranges need no rejection: to check the code generated,
+// compile with -S and look for the loops of run<0, 255> and run<short>.
+// g++ -std=c++14 -O2 -I.. constant_range_bench.cpp -pthread
+
+#include <cstdio>
+#include <limits>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    template <typename T, T min, T max>
+    void run(const char* name, std::size_t n) {
+        const auto constant = bench::ns_per_op(n, [n] {
+            long long sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += randomize::rand<T, min, max>();
+            }
+            bench::keep(sum);
+        });
+        const auto runtime = bench::ns_per_op(n, [n] {
+            long long sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += randomize::rand<T>(min, max);
+            }
+            bench::keep(sum);
+        });
+        std::printf("%-20s constant %5.2f  runtime %5.2f ns\n", name, constant, runtime);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto n = bench::scaled(bench::scale(argc, argv), 50000000);
+    run<int, 0, 255>("rand<int, 0, 255>", n);
+    run<short, std::numeric_limits<short>::min(), std::numeric_limits<short>::max()>("rand<short>", n);
+    run<int, 1, 6>("rand<int, 1, 6>", n);
+    run<int, 0, 1000>("rand<int, 0, 1000>", n);
+}
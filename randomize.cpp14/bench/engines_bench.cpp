@@ -0,0 +1,51 @@
+// Throughput of the engines, alone and through rand, against the
+// previous default std::mt19937_64, in ns per draw.
+// g++ -std=c++14 -O2 -I.. engines_bench.cpp -pthread
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    
+    template <typename Engine>
+    void run(const char* name, double scale) {
+        const auto n = bench::scaled(scale, 20000000);
+        Engine engine{12345};
+        const auto raw = bench::ns_per_op(n, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += engine();
+            }
+            bench::keep(sum);
+        });
+        const auto dice = bench::ns_per_op(n, [&] {
+            long long sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += rand<int, Engine>(1, 6);
+            }
+            bench::keep(sum);
+        });
+        const auto real = bench::ns_per_op(n, [&] {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += rand<double, -2, 3, Engine>();
+            }
+            bench::keep(sum);
+        });
+        std::printf("%-20s engine %5.2f  rand(1, 6) %5.2f  rand<double, -2, 3> %5.2f ns\n", name, raw, dice, real);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto scale = bench::scale(argc, argv);
+    run<std::mt19937_64>("std::mt19937_64", scale);
+    run<engines::xoshiro256starstar>("xoshiro256starstar", scale);
+    run<engines::pcg64>("pcg64", scale);
+    run<engines::splitmix64>("splitmix64", scale);
+    run<engines::wyrand>("wyrand", scale);
+}
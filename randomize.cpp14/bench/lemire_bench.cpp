@@ -0,0 +1,45 @@
+// The bounded integers of Lemire's multiply-shift reduction against
+// std::uniform_int_distribution, for each integer width, in ns per draw.
+// g++ -std=c++14 -O2 -I.. lemire_bench.cpp -pthread
+
+#include <cstdio>
+#include <random>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    template <typename Distribution, typename Engine>
+    double ns_per_draw(Distribution distribution, Engine& engine, std::size_t n) {
+        return bench::ns_per_op(n, [&] {
+            typename Distribution::result_type acc{};
+            for (std::size_t i = 0; i < n; ++i) {
+                acc ^= distribution(engine);
+            }
+            bench::keep(acc);
+        });
+    }
+    
+    template <typename T, typename Engine>
+    void width(const char* name, T min, T max, std::size_t n) {
+        Engine engine{7};
+        const auto standard = ns_per_draw(std::uniform_int_distribution<T>{min, max}, engine, n);
+        const auto lemire = ns_per_draw(randomize::details::uniform_int_distribution<T>{min, max}, engine, n);
+        std::printf("  %-8s std %5.2f  lemire %5.2f ns\n", name, standard, lemire);
+    }
+    
+    template <typename Engine>
+    void widths(const char* name, std::size_t n) {
+        std::printf("%s\n", name);
+        width<short, Engine>("int16", -1000, 1000, n);
+        width<int, Engine>("int32", -1000000, 1000000, n);
+        width<long long, Engine>("int64", -1000000000000LL, 1000000000000LL, n);
+        width<unsigned long long, Engine>("uint64", 0, ~0ULL / 3, n);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto n = bench::scaled(bench::scale(argc, argv), 20000000);
+    widths<std::mt19937_64>("std::mt19937_64", n);
+    widths<randomize::engines::xoshiro256starstar>("xoshiro256starstar", n);
+}
@@ -0,0 +1,104 @@
+// Pooled draws against one word per draw, for coins, dice, bytes, a range
+// of 3 and the range [0, 2^32], which takes a word per draw either way:
+// ns per draw with each engine, and engine words per draw. Then rand and
+// get_rand of dice, with and without randomize::pooled.
+// g++ -std=c++14 -O2 -I.. pooled_bench.cpp -pthread
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    
+    /**
+     * Engine counting the words drawn from the engine it wraps.
+     */
+    template <typename Engine>
+    struct counting {
+        using result_type = typename Engine::result_type;
+        
+        static constexpr result_type min() noexcept { return Engine::min(); }
+        static constexpr result_type max() noexcept { return Engine::max(); }
+        
+        result_type operator()() {
+            ++calls;
+            return engine();
+        }
+        
+        Engine engine{7};
+        std::size_t calls = 0;
+    };
+    
+    template <typename Distribution, typename Engine>
+    double ns_per_draw(Distribution distribution, Engine& engine, std::size_t n) {
+        return bench::ns_per_op(n, [&] {
+            std::uint64_t acc = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                acc += static_cast<std::uint64_t>(distribution(engine));
+            }
+            bench::keep(acc);
+        });
+    }
+    
+    template <typename Distribution, typename Engine>
+    double words_per_draw(Distribution distribution, std::size_t n) {
+        counting<Engine> engine;
+        for (std::size_t i = 0; i < n; ++i) {
+            bench::keep(distribution(engine));
+        }
+        return static_cast<double>(engine.calls) / static_cast<double>(n);
+    }
+    
+    template <typename T, typename Engine>
+    void range(const char* name, T min, T max, std::size_t n) {
+        using single = details::uniform_int_distribution<T>;
+        using pool = details::pooled_int_distribution<T>;
+        Engine engine{7};
+        const auto single_ns = ns_per_draw(single{min, max}, engine, n);
+        const auto pooled_ns = ns_per_draw(pool{min, max}, engine, n);
+        const auto single_words = words_per_draw<single, Engine>(single{min, max}, n / 10);
+        const auto pooled_words = words_per_draw<pool, Engine>(pool{min, max}, n / 10);
+        std::printf("  %-10s %5.2f ns %6.4f words  pooled %5.2f ns %6.4f words\n",
+                    name, single_ns, single_words, pooled_ns, pooled_words);
+    }
+    
+    template <typename Engine>
+    void ranges(const char* name, std::size_t n) {
+        std::printf("%s\n", name);
+        range<int, Engine>("coin", 0, 1, n);
+        range<int, Engine>("die", 1, 6, n);
+        range<std::uint8_t, Engine>("byte", 0, std::numeric_limits<std::uint8_t>::max(), n);
+        range<int, Engine>("range 3", 0, 2, n);
+        range<std::uint64_t, Engine>("2^32 + 1", 0, std::uint64_t{1} << 32, n);
+    }
+    
+    template <typename F>
+    double ns_per_call(std::size_t n, F f) {
+        return bench::ns_per_op(n, [n, &f] {
+            long long sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += f();
+            }
+            bench::keep(sum);
+        });
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto n = bench::scaled(bench::scale(argc, argv), 20000000);
+    ranges<std::mt19937_64>("std::mt19937_64", n);
+    ranges<engines::xoshiro256starstar>("xoshiro256starstar", n);
+    
+    auto dice = get_rand(1, 6);
+    auto pooled_dice = get_rand(pooled, 1, 6);
+    std::printf("default engine\n");
+    std::printf("  rand<int, 1, 6>()  %5.2f ns  pooled %5.2f ns\n",
+                ns_per_call(n, [] { return rand<int, 1, 6>(); }), ns_per_call(n, [] { return rand<int, 1, 6>(pooled); }));
+    std::printf("  get_rand(1, 6)     %5.2f ns  pooled %5.2f ns\n",
+                ns_per_call(n, [&dice] { return dice(); }), ns_per_call(n, [&pooled_dice] { return pooled_dice(); }));
+}
@@ -0,0 +1,70 @@
+// The engine memory of 200 rand<int, 0, k> instantiations, which share a
+// single engine, against one std::mt19937_64 per instantiation, and the
+// time per draw when the ranges are used in turn, with the shared engine
+// and with an engine per range.
+// g++ -std=c++14 -O2 -I.. ranges_memory_bench.cpp -pthread
+
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    constexpr std::size_t ranges = 200;
+    
+    template <int k>
+    using distribution = decltype(randomize::details::uniform_distribution<int, 0, k>());
+    
+    template <int... k>
+    std::size_t distributions_size(std::integer_sequence<int, k...>) {
+        std::size_t size = 0;
+        for (auto s : {sizeof(distribution<k + 1>)...}) {
+            size += s;
+        }
+        return size;
+    }
+    
+    /**
+     * @return - the sum of one draw from each range.
+     */
+    template <int... k>
+    long long draw_all(std::integer_sequence<int, k...>) {
+        long long sum = 0;
+        for (auto value : {randomize::rand<int, 0, k + 1>()...}) {
+            sum += value;
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto n = bench::scaled(bench::scale(argc, argv), 200000);
+    const auto sequence = std::make_integer_sequence<int, ranges>{};
+    
+    const auto before = ranges * sizeof(std::mt19937_64);
+    const auto after = sizeof(randomize::default_engine) + distributions_size(sequence);
+    std::printf("%zu ranges: engine memory %zu bytes, one std::mt19937_64 each %zu bytes\n", ranges, after, before);
+    
+    const auto ns = bench::ns_per_op(n * ranges, [&] {
+        long long sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += draw_all(sequence);
+        }
+        bench::keep(sum);
+    });
+    
+    std::vector<std::mt19937_64> engines(ranges);
+    const auto separate = bench::ns_per_op(n * ranges, [&] {
+        long long sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = 0; k < ranges; ++k) {
+                sum += std::uniform_int_distribution<int>{0, static_cast<int>(k) + 1}(engines[k]);
+            }
+        }
+        bench::keep(sum);
+    });
+    std::printf("ranges in turn: shared engine %.2f  engine per range %.2f ns per draw\n", ns, separate);
+}
@@ -0,0 +1,66 @@
+// sfmt19937_64 and dsfmt19937, which regenerate their whole state with
+// SIMD, against std::mt19937_64, for single draws and bulk fills, in ns
+// per number.
+// g++ -std=c++14 -O2 -I.. sfmt_bench.cpp -pthread
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    
+    template <typename Engine>
+    void single(const char* name, std::size_t n) {
+        Engine engine{1};
+        const auto raw = bench::ns_per_op(n, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += engine();
+            }
+            bench::keep(sum);
+        });
+        const auto real = bench::ns_per_op(n, [n] {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += rand<double, Engine>(0., 1.);
+            }
+            bench::keep(sum);
+        });
+        std::printf("%-16s single: engine %5.2f  rand<double> %5.2f ns\n", name, raw, real);
+    }
+    
+    template <typename Engine>
+    void bulk(const char* name, std::size_t n) {
+        std::vector<double> reals(4096);
+        std::vector<int> ints(4096);
+        const auto rounds = n / reals.size() + 1;
+        const auto real = bench::ns_per_op(rounds * reals.size(), [&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                fill<double, Engine>(reals, 0., 1.);
+            }
+            bench::keep(reals[7]);
+        });
+        const auto integer = bench::ns_per_op(rounds * ints.size(), [&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                fill<int, Engine>(ints, 1, 6);
+            }
+            bench::keep(ints[7]);
+        });
+        std::printf("%-16s fill 4K: double %5.2f  int %5.2f ns\n", name, real, integer);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto n = bench::scaled(bench::scale(argc, argv), 50000000);
+    single<std::mt19937_64>("std::mt19937_64", n);
+    single<engines::sfmt19937_64>("sfmt19937_64", n);
+    single<engines::dsfmt19937>("dsfmt19937", n);
+    bulk<std::mt19937_64>("std::mt19937_64", n);
+    bulk<engines::sfmt19937_64>("sfmt19937_64", n);
+    bulk<engines::dsfmt19937>("dsfmt19937", n);
+}
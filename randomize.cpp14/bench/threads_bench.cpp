@@ -0,0 +1,68 @@
+// Scaling of rand with the number of threads, with the thread-local
+// engines, against a std::mt19937_64 shared behind a mutex, in millions
+// of draws per second.
+// g++ -std=c++14 -O2 -I.. threads_bench.cpp -pthread
+
+#define RANDOMIZE_THREAD_LOCAL_ENGINES
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "randomize.hpp"
+
+namespace {
+    /**
+     * Run f(draws) in each of threads threads.
+     * @return - the number of draws per second, in millions.
+     */
+    template <typename F>
+    double throughput(unsigned threads, std::size_t draws, F f) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back(f, draws);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(draws) * threads / elapsed.count() / 1e6;
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto draws = bench::scaled(bench::scale(argc, argv), 20000000);
+    const auto cores = std::max(1u, std::thread::hardware_concurrency());
+    
+    std::mutex mutex;
+    std::mt19937_64 shared_engine{42};
+    std::uniform_real_distribution<double> shared_distribution{-2, 3};
+    
+    for (unsigned threads = 1; ; threads = std::min(2 * threads, cores)) {
+        const auto local = throughput(threads, draws, [](std::size_t n) {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += randomize::rand<double, -2, 3>();
+            }
+            bench::keep(sum);
+        });
+        const auto locked = throughput(threads, draws / 10, [&](std::size_t n) {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::lock_guard<std::mutex> lock{mutex};
+                sum += shared_distribution(shared_engine);
+            }
+            bench::keep(sum);
+        });
+        std::printf("%3u threads  thread-local %8.1f  shared with a mutex %7.1f M draws/s\n", threads, local, locked);
+        if (threads == cores) {
+            break;
+        }
+    }
+}
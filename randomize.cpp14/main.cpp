@@ -31,6 +31,12 @@ int main() {
     std::vector<float> v(randomize::rand(5, 1'000));
     std::generate(std::begin(v), std::end(v), randomize::get_rand(-100.f, 100.f));
     std::copy(std::begin(v), std::end(v), std::ostream_iterator<float>(std::cout, " "));
+    std::cout << '\n';
+    
+    // (8) fill a vector with random numbers within range [1 ; 6], much faster
+    std::vector<int> w(randomize::rand(5, 100));
+    randomize::fill(w, 1, 6);
+    std::copy(std::begin(w), std::end(w), std::ostream_iterator<int>(std::cout, " "));
     
     // flush!
     std::cout << std::endl;
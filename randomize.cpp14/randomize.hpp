@@ -7,212 +7,4817 @@
 #ifndef randomize_h
 #define randomize_h
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
-#include <unordered_map>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define RANDOMIZE_SSE2
+#endif
+
+#if defined(__linux__)
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #if defined(SYS_getrandom)
+        #define RANDOMIZE_GETRANDOM
+    #endif
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <pthread.h>
+    #define RANDOMIZE_ATFORK
+#endif
+
+/**
+ * The engine used when none is given explicitly to rand or
+ * get_rand. Define it before including this file to change
+ * the policy globally, e.g. to randomize::engines::xoshiro256starstar.
+ */
+#if !defined(RANDOMIZE_DEFAULT_ENGINE)
+    #define RANDOMIZE_DEFAULT_ENGINE std::mt19937_64
+#endif
+
+/**
+ * By default, engines are shared static variables, which must
+ * not be used concurrently. Define RANDOMIZE_THREAD_LOCAL_ENGINES
+ * before including this file so that each thread gets its own,
+ * independently seeded, engines instead.
+ */
+#if defined(RANDOMIZE_THREAD_LOCAL_ENGINES)
+    #define RANDOMIZE_ENGINE_STORAGE thread_local
+#else
+    #define RANDOMIZE_ENGINE_STORAGE static
+#endif
+
+/**
+ * Number of distributions memoized by get_rand for each type, beyond
+ * which entries are evicted with CLOCK (second chance): an entry used
+ * since the hand last passed it is spared once. It is split evenly
+ * across the shards of the cache, so it is rounded up to a multiple
+ * of 64. Define it before including this file to change it.
+ */
+#if !defined(RANDOMIZE_GET_RAND_CAPACITY)
+    #define RANDOMIZE_GET_RAND_CAPACITY 65536
+#endif
+
+/**
+ * On x86 with GCC or Clang, the bulk generation kernels are compiled
+ * for several instruction sets, and the best one supported by the CPU
+ * is picked at runtime. Define RANDOMIZE_NO_DISPATCH to disable it.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(RANDOMIZE_NO_DISPATCH)
+    #define RANDOMIZE_X86_DISPATCH
+    #if defined(__clang__)
+        #define RANDOMIZE_TARGET(isa) __attribute__((target(isa)))
+    #else
+        // Implicit contractions to FMA would make the result depend on the instruction set
+        #define RANDOMIZE_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+    #endif
+#endif
+
+#if defined(__GNUC__)
+    #define RANDOMIZE_ALWAYS_INLINE inline __attribute__((always_inline))
+    #define RANDOMIZE_NOINLINE __attribute__((noinline))
+    #define RANDOMIZE_RESTRICT __restrict__
+    #define RANDOMIZE_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#elif defined(_MSC_VER)
+    #define RANDOMIZE_ALWAYS_INLINE __forceinline
+    #define RANDOMIZE_NOINLINE __declspec(noinline)
+    #define RANDOMIZE_RESTRICT __restrict
+    #define RANDOMIZE_UNLIKELY(condition) (condition)
+#else
+    #define RANDOMIZE_ALWAYS_INLINE inline
+    #define RANDOMIZE_NOINLINE
+    #define RANDOMIZE_RESTRICT
+    #define RANDOMIZE_UNLIKELY(condition) (condition)
+#endif
 
 namespace randomize {
     namespace details {
+        #if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 uint128_t;
+        #endif
+        
+        /**
+         * Full 64x64 -> 128 bits multiplication.
+         * @return - the low 64 bits of the product, the high
+         * 64 bits are stored in hi.
+         */
+        inline std::uint64_t umul128(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept {
+            #if defined(__SIZEOF_INT128__)
+                const auto product = static_cast<uint128_t>(a) * b;
+                hi = static_cast<std::uint64_t>(product >> 64);
+                return static_cast<std::uint64_t>(product);
+            #else
+                const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+                const std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+                const std::uint64_t lo_lo = a_lo * b_lo;
+                const std::uint64_t hi_lo = a_hi * b_lo;
+                const std::uint64_t lo_hi = a_lo * b_hi;
+                const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+                hi = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+                return (cross << 32) | (lo_lo & 0xffffffff);
+            #endif
+        }
+        
+        /**
+         * Bitwise left rotation.
+         * @return - x rotated by k bits.
+         */
+        constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+            return (x << k) | (x >> ((64 - k) & 63));
+        }
+        
+        /**
+         * Bitwise right rotation.
+         * @return - x rotated by k bits.
+         */
+        constexpr std::uint64_t rotr(std::uint64_t x, int k) noexcept {
+            return (x >> k) | (x << ((64 - k) & 63));
+        }
+        
+        /**
+         * Bitwise left rotation of a 32 bits word.
+         * @return - x rotated by k bits.
+         */
+        constexpr std::uint32_t rotl32(std::uint32_t x, int k) noexcept {
+            return (x << k) | (x >> ((32 - k) & 31));
+        }
+        
+        /**
+         * Finalizer of splitmix64, a strong 64 bits mixing function.
+         * @return - the mixed value.
+         */
+        constexpr std::uint64_t mix64(std::uint64_t z) noexcept {
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+        
+        /**
+         * Whether SeedSequence is a seed sequence for Engine, as opposed
+         * to a seed or to Engine itself, like in the constructors of the
+         * standard engines.
+         */
+        template <typename SeedSequence, typename Engine>
+        struct is_seed_sequence : std::integral_constant<bool,
+            !std::is_convertible<SeedSequence, typename Engine::result_type>::value
+            && !std::is_same<std::remove_cv_t<SeedSequence>, Engine>::value> {};
+        
+        /**
+         * Fill 64 bits words with a single call to seq.generate, as each
+         * call starts the sequence over.
+         */
+        template <typename SeedSequence, std::size_t Size>
+        void seed_words(SeedSequence& seq, std::uint64_t (&words)[Size]) {
+            std::uint32_t buffer[2 * Size];
+            seq.generate(buffer, buffer + 2 * Size);
+            for (std::size_t i = 0; i < Size; ++i) {
+                words[i] = buffer[2 * i] | (static_cast<std::uint64_t>(buffer[2 * i + 1]) << 32);
+            }
+        }
+        
+        /**
+         * State transition of the xoshiro256 generators.
+         */
+        inline void xoshiro256_step(std::uint64_t (&state)[4]) noexcept {
+            const auto t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+        }
+        
+        /**
+         * Jump polynomial of the xoshiro256 generators: it advances
+         * their state by 2^128 steps.
+         */
+        constexpr std::uint64_t xoshiro256_jump_polynomial[4] = {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+        };
+        
+        /**
+         * Long jump polynomial of the xoshiro256 generators: it advances
+         * their state by 2^192 steps.
+         */
+        constexpr std::uint64_t xoshiro256_long_jump_polynomial[4] = {
+            0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+        };
+        
+        /**
+         * Advance a xoshiro256 state by applying a jump polynomial.
+         */
+        inline void xoshiro256_jump(std::uint64_t (&state)[4], const std::uint64_t (&polynomial)[4]) noexcept {
+            std::uint64_t jumped[4] = {0, 0, 0, 0};
+            for (auto word : polynomial) {
+                for (int bit = 0; bit < 64; ++bit) {
+                    if ((word >> bit) & 1) {
+                        for (int i = 0; i < 4; ++i) {
+                            jumped[i] ^= state[i];
+                        }
+                    }
+                    xoshiro256_step(state);
+                }
+            }
+            for (int i = 0; i < 4; ++i) {
+                state[i] = jumped[i];
+            }
+        }
+        
+        /**
+         * Seed a xoshiro256 state from a seed sequence, avoiding the all
+         * zero state, which is a fixed point.
+         */
+        template <typename SeedSequence>
+        void xoshiro256_seed(std::uint64_t (&state)[4], SeedSequence& seq) {
+            seed_words(seq, state);
+            if ((state[0] | state[1] | state[2] | state[3]) == 0) {
+                state[0] = 1;
+            }
+        }
+        
+        /**
+         * Instruction sets for which the bulk kernels are compiled.
+         */
+        enum class instruction_set { generic, avx2, avx512 };
+        
+        /**
+         * Detect, once, the best instruction set supported by the CPU.
+         * @return - the instruction set.
+         */
+        inline instruction_set current_instruction_set() noexcept {
+            #if defined(RANDOMIZE_X86_DISPATCH)
+                static const auto isa = [] {
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+                        return instruction_set::avx512;
+                    }
+                    return __builtin_cpu_supports("avx2") ? instruction_set::avx2 : instruction_set::generic;
+                }();
+                return isa;
+            #else
+                return instruction_set::generic;
+            #endif
+        }
+        
+        /**
+         * steps iterations of Lanes independent xoshiro256+ generators,
+         * stored as structure of arrays so that each operation on the
+         * lanes compiles to a single vector instruction.
+         */
+        template <std::size_t Lanes>
+        RANDOMIZE_ALWAYS_INLINE void xoshiro256plus_lanes_kernel(std::uint64_t* RANDOMIZE_RESTRICT state,
+                                                                 std::uint64_t* RANDOMIZE_RESTRICT output,
+                                                                 std::size_t steps) noexcept {
+            std::uint64_t s0[Lanes], s1[Lanes], s2[Lanes], s3[Lanes];
+            for (std::size_t l = 0; l < Lanes; ++l) {
+                s0[l] = state[l];
+                s1[l] = state[Lanes + l];
+                s2[l] = state[2 * Lanes + l];
+                s3[l] = state[3 * Lanes + l];
+            }
+            for (std::size_t step = 0; step < steps; ++step, output += Lanes) {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    output[l] = s0[l] + s3[l];
+                    const auto t = s1[l] << 17;
+                    s2[l] ^= s0[l];
+                    s3[l] ^= s1[l];
+                    s1[l] ^= s2[l];
+                    s0[l] ^= s3[l];
+                    s2[l] ^= t;
+                    s3[l] = rotl(s3[l], 45);
+                }
+            }
+            for (std::size_t l = 0; l < Lanes; ++l) {
+                state[l] = s0[l];
+                state[Lanes + l] = s1[l];
+                state[2 * Lanes + l] = s2[l];
+                state[3 * Lanes + l] = s3[l];
+            }
+        }
+        
+        template <std::size_t Lanes>
+        void xoshiro256plus_lanes_generic(std::uint64_t* state, std::uint64_t* output, std::size_t steps) noexcept {
+            xoshiro256plus_lanes_kernel<Lanes>(state, output, steps);
+        }
+        
+        #if defined(RANDOMIZE_X86_DISPATCH)
+            template <std::size_t Lanes>
+            RANDOMIZE_TARGET("avx2")
+            void xoshiro256plus_lanes_avx2(std::uint64_t* state, std::uint64_t* output, std::size_t steps) noexcept {
+                xoshiro256plus_lanes_kernel<Lanes>(state, output, steps);
+            }
+            
+            template <std::size_t Lanes>
+            RANDOMIZE_TARGET("avx512f,avx512dq")
+            void xoshiro256plus_lanes_avx512(std::uint64_t* state, std::uint64_t* output, std::size_t steps) noexcept {
+                xoshiro256plus_lanes_kernel<Lanes>(state, output, steps);
+            }
+        #endif
+        
+        /**
+         * Run xoshiro256plus_lanes_kernel with the best instruction set.
+         */
+        template <std::size_t Lanes>
+        void xoshiro256plus_lanes(std::uint64_t* state, std::uint64_t* output, std::size_t steps) noexcept {
+            #if defined(RANDOMIZE_X86_DISPATCH)
+                switch (current_instruction_set()) {
+                    case instruction_set::avx512:
+                        return xoshiro256plus_lanes_avx512<Lanes>(state, output, steps);
+                    case instruction_set::avx2:
+                        return xoshiro256plus_lanes_avx2<Lanes>(state, output, steps);
+                    case instruction_set::generic:
+                        break;
+                }
+            #endif
+            xoshiro256plus_lanes_generic<Lanes>(state, output, steps);
+        }
+        
+        /**
+         * ChaCha quarter round on the words a, b, c and d of Lanes blocks.
+         */
+        template <std::size_t Lanes>
+        RANDOMIZE_ALWAYS_INLINE void chacha_quarter_round(std::uint32_t (&x)[16][Lanes], int a, int b, int c, int d) noexcept {
+            for (std::size_t l = 0; l < Lanes; ++l) {
+                x[a][l] += x[b][l]; x[d][l] = rotl32(x[d][l] ^ x[a][l], 16);
+                x[c][l] += x[d][l]; x[b][l] = rotl32(x[b][l] ^ x[c][l], 12);
+                x[a][l] += x[b][l]; x[d][l] = rotl32(x[d][l] ^ x[a][l], 8);
+                x[c][l] += x[d][l]; x[b][l] = rotl32(x[b][l] ^ x[c][l], 7);
+            }
+        }
+        
+        /**
+         * ChaCha block function (Bernstein, 2008) on Lanes consecutive
+         * blocks, starting at counter. The 16 words of the blocks are
+         * stored as structure of arrays, so that each operation on the
+         * lanes compiles to a single vector instruction. The words 12 and
+         * 13 hold the 64 bits block counter, 14 and 15 the 64 bits stream;
+         * the block i is written as 8 little endian 64 bits outputs at
+         * output[8 * i].
+         */
+        template <int Rounds, std::size_t Lanes>
+        RANDOMIZE_ALWAYS_INLINE void chacha_blocks_kernel(const std::uint32_t* RANDOMIZE_RESTRICT key, std::uint64_t counter,
+                                                          std::uint64_t stream, std::uint64_t* RANDOMIZE_RESTRICT output) noexcept {
+            const std::uint32_t input[16] = {
+                0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+                key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+                0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)
+            };
+            
+            std::uint32_t x[16][Lanes];
+            for (std::size_t i = 0; i < 16; ++i) {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    x[i][l] = input[i];
+                }
+            }
+            for (std::size_t l = 0; l < Lanes; ++l) {
+                x[12][l] = static_cast<std::uint32_t>(counter + l);
+                x[13][l] = static_cast<std::uint32_t>((counter + l) >> 32);
+            }
+            
+            for (int round = 0; round < Rounds; round += 2) {
+                chacha_quarter_round(x, 0, 4, 8, 12);
+                chacha_quarter_round(x, 1, 5, 9, 13);
+                chacha_quarter_round(x, 2, 6, 10, 14);
+                chacha_quarter_round(x, 3, 7, 11, 15);
+                chacha_quarter_round(x, 0, 5, 10, 15);
+                chacha_quarter_round(x, 1, 6, 11, 12);
+                chacha_quarter_round(x, 2, 7, 8, 13);
+                chacha_quarter_round(x, 3, 4, 9, 14);
+            }
+            
+            for (std::size_t l = 0; l < Lanes; ++l) {
+                x[12][l] += static_cast<std::uint32_t>(counter + l);
+                x[13][l] += static_cast<std::uint32_t>((counter + l) >> 32);
+            }
+            for (std::size_t i = 0; i < 8; ++i) {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    const auto lo = x[2 * i][l] + input[2 * i];
+                    const auto hi = x[2 * i + 1][l] + input[2 * i + 1];
+                    output[8 * l + i] = (static_cast<std::uint64_t>(hi) << 32) | lo;
+                }
+            }
+        }
+        
+        template <int Rounds, std::size_t Lanes>
+        void chacha_blocks_generic(const std::uint32_t* key, std::uint64_t counter, std::uint64_t stream, std::uint64_t* output) noexcept {
+            chacha_blocks_kernel<Rounds, Lanes>(key, counter, stream, output);
+        }
+        
+        #if defined(RANDOMIZE_X86_DISPATCH)
+            template <int Rounds, std::size_t Lanes>
+            RANDOMIZE_TARGET("avx2")
+            void chacha_blocks_avx2(const std::uint32_t* key, std::uint64_t counter, std::uint64_t stream, std::uint64_t* output) noexcept {
+                chacha_blocks_kernel<Rounds, Lanes>(key, counter, stream, output);
+            }
+            
+            template <int Rounds, std::size_t Lanes>
+            RANDOMIZE_TARGET("avx512f,avx512dq")
+            void chacha_blocks_avx512(const std::uint32_t* key, std::uint64_t counter, std::uint64_t stream, std::uint64_t* output) noexcept {
+                chacha_blocks_kernel<Rounds, Lanes>(key, counter, stream, output);
+            }
+        #endif
+        
+        /**
+         * Run chacha_blocks_kernel with the best instruction set.
+         */
+        template <int Rounds, std::size_t Lanes>
+        void chacha_blocks(const std::uint32_t* key, std::uint64_t counter, std::uint64_t stream, std::uint64_t* output) noexcept {
+            #if defined(RANDOMIZE_X86_DISPATCH)
+                switch (current_instruction_set()) {
+                    case instruction_set::avx512:
+                        return chacha_blocks_avx512<Rounds, Lanes>(key, counter, stream, output);
+                    case instruction_set::avx2:
+                        return chacha_blocks_avx2<Rounds, Lanes>(key, counter, stream, output);
+                    case instruction_set::generic:
+                        break;
+                }
+            #endif
+            chacha_blocks_generic<Rounds, Lanes>(key, counter, stream, output);
+        }
+        
+        /**
+         * Parameters of SFMT19937 and dSFMT19937 (Saito, Matsumoto), the
+         * SIMD-oriented Mersenne Twisters: their state is a sequence of
+         * 128 bits words, regenerated all at once.
+         */
+        struct sfmt19937_params {
+            static constexpr std::size_t n = 156;
+            static constexpr std::size_t pos1 = 122;
+            static constexpr int sl1 = 18;
+            static constexpr int sr1 = 11;
+            static constexpr std::uint32_t msk1 = 0xdfffffefU;
+            static constexpr std::uint32_t msk2 = 0xddfecb7fU;
+            static constexpr std::uint32_t msk3 = 0xbffaffffU;
+            static constexpr std::uint32_t msk4 = 0xbffffff6U;
+            static constexpr std::uint32_t parity1 = 0x00000001U;
+            static constexpr std::uint32_t parity4 = 0x13c9e684U;
+        };
+        
+        struct dsfmt19937_params {
+            static constexpr std::size_t n = 191;
+            static constexpr std::size_t pos1 = 117;
+            static constexpr int sl1 = 19;
+            static constexpr int sr = 12;
+            static constexpr std::uint64_t msk1 = 0x000ffafffffffb3fULL;
+            static constexpr std::uint64_t msk2 = 0x000ffdfffc90fffdULL;
+            static constexpr std::uint64_t fix1 = 0x90014964b32f4329ULL;
+            static constexpr std::uint64_t fix2 = 0x3b8d12ac548a7c7aULL;
+            static constexpr std::uint64_t pcv1 = 0x3d84e1ac0dc82880ULL;
+            static constexpr std::uint64_t pcv2 = 0x0000000000000001ULL;
+        };
+        
+        /**
+         * SFMT19937 recursion on one 128 bits word, seen as four 32 bits
+         * words, with the 128 bits shifts SL2 and SR2 of one byte.
+         */
+        inline void sfmt19937_recursion(std::uint32_t* r, const std::uint32_t* a, const std::uint32_t* b,
+                                        const std::uint32_t* c, const std::uint32_t* d) noexcept {
+            using params = sfmt19937_params;
+            const std::uint32_t x[4] = {a[0] << 8, (a[1] << 8) | (a[0] >> 24), (a[2] << 8) | (a[1] >> 24), (a[3] << 8) | (a[2] >> 24)};
+            const std::uint32_t y[4] = {(c[0] >> 8) | (c[1] << 24), (c[1] >> 8) | (c[2] << 24), (c[2] >> 8) | (c[3] << 24), c[3] >> 8};
+            const std::uint32_t msk[4] = {params::msk1, params::msk2, params::msk3, params::msk4};
+            for (std::size_t i = 0; i < 4; ++i) {
+                r[i] = a[i] ^ x[i] ^ ((b[i] >> params::sr1) & msk[i]) ^ y[i] ^ (d[i] << params::sl1);
+            }
+        }
+        
+        /**
+         * Regenerate the whole SFMT19937 state.
+         */
+        inline void sfmt19937_generate(std::uint32_t* state) noexcept {
+            using params = sfmt19937_params;
+            constexpr auto n = params::n;
+            constexpr auto pos1 = params::pos1;
+            #if defined(RANDOMIZE_SSE2)
+                auto word = [state](std::size_t i) { return reinterpret_cast<__m128i*>(state + 4 * i); };
+                const auto mask = _mm_set_epi32(static_cast<int>(params::msk4), static_cast<int>(params::msk3),
+                                                static_cast<int>(params::msk2), static_cast<int>(params::msk1));
+                auto recursion = [mask](__m128i a, __m128i b, __m128i c, __m128i d) {
+                    const auto y = _mm_and_si128(_mm_srli_epi32(b, params::sr1), mask);
+                    const auto z = _mm_xor_si128(_mm_xor_si128(_mm_srli_si128(c, 1), a), _mm_slli_epi32(d, params::sl1));
+                    return _mm_xor_si128(_mm_xor_si128(z, _mm_slli_si128(a, 1)), y);
+                };
+                auto r1 = _mm_load_si128(word(n - 2));
+                auto r2 = _mm_load_si128(word(n - 1));
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto j = i < n - pos1 ? i + pos1 : i + pos1 - n;
+                    const auto r = recursion(_mm_load_si128(word(i)), _mm_load_si128(word(j)), r1, r2);
+                    _mm_store_si128(word(i), r);
+                    r1 = r2;
+                    r2 = r;
+                }
+            #else
+                const std::uint32_t* r1 = state + 4 * (n - 2);
+                const std::uint32_t* r2 = state + 4 * (n - 1);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto j = i < n - pos1 ? i + pos1 : i + pos1 - n;
+                    sfmt19937_recursion(state + 4 * i, state + 4 * i, state + 4 * j, r1, r2);
+                    r1 = r2;
+                    r2 = state + 4 * i;
+                }
+            #endif
+        }
+        
+        /**
+         * Regenerate the whole dSFMT19937 state: n 128 bits words of
+         * two doubles in [1, 2), followed by the 128 bits "lung".
+         */
+        inline void dsfmt19937_generate(std::uint64_t* state) noexcept {
+            using params = dsfmt19937_params;
+            constexpr auto n = params::n;
+            constexpr auto pos1 = params::pos1;
+            #if defined(RANDOMIZE_SSE2)
+                auto word = [state](std::size_t i) { return reinterpret_cast<__m128i*>(state + 2 * i); };
+                const auto mask = _mm_set_epi64x(static_cast<long long>(params::msk2), static_cast<long long>(params::msk1));
+                auto lung = _mm_load_si128(word(n));
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto j = i < n - pos1 ? i + pos1 : i + pos1 - n;
+                    const auto a = _mm_load_si128(word(i));
+                    const auto z = _mm_xor_si128(_mm_slli_epi64(a, params::sl1), _mm_load_si128(word(j)));
+                    lung = _mm_xor_si128(_mm_shuffle_epi32(lung, 0x1b), z);
+                    const auto r = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi64(lung, params::sr), _mm_and_si128(lung, mask)), a);
+                    _mm_store_si128(word(i), r);
+                }
+                _mm_store_si128(word(n), lung);
+            #else
+                std::uint64_t lung[2] = {state[2 * n], state[2 * n + 1]};
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto j = i < n - pos1 ? i + pos1 : i + pos1 - n;
+                    const std::uint64_t a[2] = {state[2 * i], state[2 * i + 1]};
+                    const std::uint64_t l0 = lung[0], l1 = lung[1];
+                    lung[0] = (a[0] << params::sl1) ^ (l1 >> 32) ^ (l1 << 32) ^ state[2 * j];
+                    lung[1] = (a[1] << params::sl1) ^ (l0 >> 32) ^ (l0 << 32) ^ state[2 * j + 1];
+                    state[2 * i] = (lung[0] >> params::sr) ^ (lung[0] & params::msk1) ^ a[0];
+                    state[2 * i + 1] = (lung[1] >> params::sr) ^ (lung[1] & params::msk2) ^ a[1];
+                }
+                state[2 * n] = lung[0];
+                state[2 * n + 1] = lung[1];
+            #endif
+        }
+        
+        /**
+         * The MT initialization takes a 32 bits seed: larger seeds are
+         * hashed down to 32 bits, the others are kept as they are so that
+         * the output matches the reference implementations.
+         * @return - the 32 bits seed.
+         */
+        constexpr std::uint32_t mt_seed32(std::uint64_t seed) noexcept {
+            return seed >> 32 == 0 ? static_cast<std::uint32_t>(seed) : static_cast<std::uint32_t>(mix64(seed) >> 32);
+        }
+        
+        /**
+         * Polynomials over GF(2): the bit i % 64 of the word i / 64 is
+         * the coefficient of x^i. The engines whose transition T is linear
+         * over GF(2) jump n steps ahead by evaluating x^n mod p(x) at T, p
+         * being the minimal polynomial of T.
+         */
+        using gf2_polynomial = std::vector<std::uint64_t>;
+        
+        /**
+         * @return - the degree of a polynomial, -1 for zero.
+         */
+        inline int gf2_degree(const gf2_polynomial& a) noexcept {
+            for (auto i = a.size(); i-- != 0;) {
+                for (int bit = 63; bit >= 0; --bit) {
+                    if ((a[i] >> bit) & 1) {
+                        return static_cast<int>(64 * i) + bit;
+                    }
+                }
+            }
+            return -1;
+        }
+        
+        /**
+         * a += b * x^shift
+         */
+        inline void gf2_add_shifted(gf2_polynomial& a, const gf2_polynomial& b, std::size_t shift) {
+            const auto words = shift / 64;
+            const auto bits = static_cast<int>(shift % 64);
+            if (a.size() < b.size() + words + 1) {
+                a.resize(b.size() + words + 1, 0);
+            }
+            for (std::size_t i = 0; i < b.size(); ++i) {
+                a[i + words] ^= b[i] << bits;
+                if (bits != 0) {
+                    a[i + words + 1] ^= b[i] >> (64 - bits);
+                }
+            }
+        }
+        
+        /**
+         * @return - a mod p.
+         */
+        inline gf2_polynomial gf2_mod(gf2_polynomial a, const gf2_polynomial& p) {
+            const auto degree = gf2_degree(p);
+            for (auto i = gf2_degree(a); i >= degree; --i) {
+                if ((a[static_cast<std::size_t>(i) / 64] >> (i % 64)) & 1) {
+                    gf2_add_shifted(a, p, static_cast<std::size_t>(i - degree));
+                }
+            }
+            a.resize(static_cast<std::size_t>(degree) / 64 + 1);
+            return a;
+        }
+        
+        /**
+         * @return - a^2, which only spreads the bits of a.
+         */
+        inline gf2_polynomial gf2_square(const gf2_polynomial& a) {
+            auto spread = [](std::uint64_t x) {
+                x &= 0xffffffffULL;
+                x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+                x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+                x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+                x = (x | (x << 2)) & 0x3333333333333333ULL;
+                return (x | (x << 1)) & 0x5555555555555555ULL;
+            };
+            gf2_polynomial square(2 * a.size());
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                square[2 * i] = spread(a[i]);
+                square[2 * i + 1] = spread(a[i] >> 32);
+            }
+            return square;
+        }
+        
+        /**
+         * @return - a * b.
+         */
+        inline gf2_polynomial gf2_multiply(const gf2_polynomial& a, const gf2_polynomial& b) {
+            gf2_polynomial product(a.size() + b.size() + 1, 0);
+            const auto degree = gf2_degree(a);
+            for (int i = 0; i <= degree; ++i) {
+                if ((a[static_cast<std::size_t>(i) / 64] >> (i % 64)) & 1) {
+                    gf2_add_shifted(product, b, static_cast<std::size_t>(i));
+                }
+            }
+            return product;
+        }
+        
+        /**
+         * @return - a * b mod p.
+         */
+        inline gf2_polynomial gf2_multiply_mod(const gf2_polynomial& a, const gf2_polynomial& b, const gf2_polynomial& p) {
+            return gf2_mod(gf2_multiply(a, b), p);
+        }
+        
+        /**
+         * @return - a^e mod p.
+         */
+        inline gf2_polynomial gf2_power_mod(const gf2_polynomial& a, unsigned long long e, const gf2_polynomial& p) {
+            gf2_polynomial power{1};
+            for (int i = 63; i >= 0; --i) {
+                if (power.size() != 1 || power[0] != 1) {
+                    power = gf2_mod(gf2_square(power), p);
+                }
+                if ((e >> i) & 1) {
+                    power = gf2_multiply_mod(power, a, p);
+                }
+            }
+            return power;
+        }
+        
+        /**
+         * x^e mod p, the exponent e being given by its 64 bits words,
+         * least significant first.
+         * @return - the jump polynomial of e steps.
+         */
+        inline gf2_polynomial gf2_x_power_mod(const std::uint64_t* exponent, std::size_t words, const gf2_polynomial& p) {
+            gf2_polynomial power{1};
+            for (auto i = 64 * words; i-- != 0;) {
+                power = gf2_mod(gf2_square(power), p);
+                if ((exponent[i / 64] >> (i % 64)) & 1) {
+                    power.push_back(0);
+                    for (auto j = power.size(); j-- != 0;) {
+                        power[j] = (power[j] << 1) | (j != 0 ? power[j - 1] >> 63 : 0);
+                    }
+                    power = gf2_mod(std::move(power), p);
+                }
+            }
+            return power;
+        }
+        
+        inline gf2_polynomial gf2_x_power_mod(std::uint64_t exponent, const gf2_polynomial& p) {
+            return gf2_x_power_mod(&exponent, 1, p);
+        }
+        
+        /**
+         * Berlekamp-Massey: the minimal polynomial of the sequence of
+         * count bits given by next_bit(). count must be at least twice the
+         * degree of the polynomial.
+         * @return - the minimal polynomial.
+         */
+        template <typename NextBit>
+        gf2_polynomial gf2_minimal_polynomial(std::size_t count, NextBit next_bit) {
+            // The sequence is stored reversed, so that the terms of each
+            // discrepancy are contiguous bits
+            const auto words = count / 64 + 2;
+            std::vector<std::uint64_t> reversed(words, 0);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto j = count - 1 - i;
+                reversed[j / 64] |= static_cast<std::uint64_t>(next_bit() & 1) << (j % 64);
+            }
+            gf2_polynomial connection{1}, previous{1};
+            std::size_t length = 0, gap = 1;
+            for (std::size_t n = 0; n < count; ++n) {
+                // sum of connection_i * s[n - i] for i in [0, length]
+                const auto offset = count - 1 - n;
+                std::uint64_t discrepancy = 0;
+                for (std::size_t i = 0; i * 64 <= length; ++i) {
+                    const auto bit = offset + 64 * i;
+                    const auto shift = bit % 64;
+                    auto window = reversed[bit / 64] >> shift;
+                    if (shift != 0) {
+                        window |= reversed[bit / 64 + 1] << (64 - shift);
+                    }
+                    discrepancy ^= window & (i < connection.size() ? connection[i] : 0);
+                }
+                for (int shift = 32; shift > 0; shift /= 2) {
+                    discrepancy ^= discrepancy >> shift;
+                }
+                if ((discrepancy & 1) == 0) {
+                    ++gap;
+                } else if (2 * length <= n) {
+                    auto swapped = connection;
+                    gf2_add_shifted(connection, previous, gap);
+                    length = n + 1 - length;
+                    previous = std::move(swapped);
+                    gap = 1;
+                } else {
+                    gf2_add_shifted(connection, previous, gap);
+                    ++gap;
+                }
+            }
+            // The minimal polynomial is the reciprocal of the connection polynomial
+            gf2_polynomial minimal(length / 64 + 1, 0);
+            for (std::size_t i = 0; i <= length; ++i) {
+                if (i / 64 < connection.size() && ((connection[i / 64] >> (i % 64)) & 1)) {
+                    const auto j = length - i;
+                    minimal[j / 64] |= std::uint64_t{1} << (j % 64);
+                }
+            }
+            return minimal;
+        }
+        
+        /**
+         * Replace a state by jump(T) applied to it, T being the linear
+         * transition applied by step(state), with Horner's scheme.
+         */
+        template <typename Word, std::size_t Size, typename Step>
+        void gf2_jump(Word (&state)[Size], const gf2_polynomial& jump, Step step) {
+            Word jumped[Size] = {};
+            const auto degree = gf2_degree(jump);
+            for (int i = 0; i <= degree; ++i) {
+                if ((jump[static_cast<std::size_t>(i) / 64] >> (i % 64)) & 1) {
+                    for (std::size_t j = 0; j < Size; ++j) {
+                        jumped[j] ^= state[j];
+                    }
+                }
+                if (i != degree) {
+                    step(state);
+                }
+            }
+            std::copy(jumped, jumped + Size, state);
+        }
+        
+        /**
+         * A polynomial p such that p(T) = 0, T being the transition
+         * applied by step(state) to states of Size words. The minimal
+         * polynomial of the sequence of a random combination of state bits
+         * is found with Berlekamp-Massey; the parts of the state which that
+         * combination happens not to see are then annihilated in turn, for
+         * a few random states. Over GF(2), a random state misses the end of
+         * a Jordan chain of T with probability 1/2, hence the result is
+         * finally multiplied by x^8 (x + 1)^8, unless it is of full degree:
+         * any multiple of the minimal polynomial of T gives the same jumps.
+         * @return - the polynomial.
+         */
+        template <typename Word, std::size_t Size, typename Step>
+        gf2_polynomial gf2_annihilating_polynomial(Step step) {
+            gf2_polynomial polynomial{1};
+            std::uint64_t round = 0;
+            for (std::size_t trial = 0; trial < 4; ++trial) {
+                Word origin[Size];
+                for (std::size_t i = 0; i < Size; ++i) {
+                    origin[i] = static_cast<Word>(mix64(trial * Size + i + 1));
+                }
+                for (;; ++round) {
+                    alignas(16) Word state[Size];
+                    std::copy(origin, origin + Size, state);
+                    gf2_jump(state, polynomial, step);
+                    if (std::all_of(state, state + Size, [](Word word) { return word == 0; })) {
+                        break;
+                    }
+                    // A different combination of state bits at each round
+                    const auto factor = gf2_minimal_polynomial(2 * Size * sizeof(Word) * 8, [&state, step, round] {
+                        std::uint64_t parity = 0;
+                        for (std::size_t i = 0; i < Size; ++i) {
+                            parity ^= state[i] & static_cast<Word>(mix64(~(round * Size + i)));
+                        }
+                        for (int shift = 32; shift > 0; shift /= 2) {
+                            parity ^= parity >> shift;
+                        }
+                        step(state);
+                        return parity;
+                    });
+                    polynomial = gf2_multiply(polynomial, factor);
+                }
+            }
+            if (static_cast<std::size_t>(gf2_degree(polynomial)) == Size * sizeof(Word) * 8) {
+                return polynomial;  // the characteristic polynomial of T
+            }
+            return gf2_multiply(polynomial, gf2_polynomial{0x10100});
+        }
+        
+        /**
+         * Polynomials which annihilate the transitions of the xoshiro256,
+         * SFMT19937 and dSFMT19937 generators (one step, and one whole
+         * state regeneration respectively), found on first use.
+         * @return - the polynomial.
+         */
+        inline const gf2_polynomial& xoshiro256_minimal_polynomial() {
+            static const auto polynomial = gf2_annihilating_polynomial<std::uint64_t, 4>(
+                [](std::uint64_t (&state)[4]) { xoshiro256_step(state); });
+            return polynomial;
+        }
+        
+        inline const gf2_polynomial& sfmt19937_minimal_polynomial() {
+            static const auto polynomial = gf2_annihilating_polynomial<std::uint32_t, 4 * sfmt19937_params::n>(sfmt19937_generate);
+            return polynomial;
+        }
+        
+        inline const gf2_polynomial& dsfmt19937_minimal_polynomial() {
+            static const auto polynomial = gf2_annihilating_polynomial<std::uint64_t, 2 * dsfmt19937_params::n + 2>(dsfmt19937_generate);
+            return polynomial;
+        }
+        
+        /**
+         * The last state_size words X(i - n), ..., X(i - 1) generated by
+         * std::mt19937_64, in that order: the state of its textual
+         * representation.
+         */
+        using mt19937_64_state = std::uint64_t[std::mt19937_64::state_size];
+        
+        /**
+         * Replace the words of the state by the next state_size ones,
+         * i.e. X(i + k) = X(i + k - n + m) ^ twist(X(i + k - n), X(i + k - n + 1)).
+         */
+        inline void mt19937_64_generate(mt19937_64_state& state) noexcept {
+            using mt = std::mt19937_64;
+            constexpr auto n = mt::state_size;
+            constexpr auto upper = ~std::uint64_t{0} << mt::mask_bits;
+            for (std::size_t k = 0; k < n; ++k) {
+                const auto y = (state[k] & upper) | (state[(k + 1) % n] & ~upper);
+                state[k] = state[(k + mt::shift_size) % n] ^ (y >> 1) ^ ((y & 1) != 0 ? mt::xor_mask : 0);
+            }
+        }
+        
+        inline const gf2_polynomial& mt19937_64_minimal_polynomial() {
+            static const auto polynomial = gf2_annihilating_polynomial<std::uint64_t, std::mt19937_64::state_size>(mt19937_64_generate);
+            return polynomial;
+        }
+        
+        /**
+         * Advance a xoshiro256 state by n steps, in O(log n).
+         */
+        inline void xoshiro256_discard(std::uint64_t (&state)[4], unsigned long long n) {
+            if (n < 256) {
+                while (n--) {
+                    xoshiro256_step(state);
+                }
+                return;
+            }
+            gf2_jump(state, gf2_x_power_mod(n, xoshiro256_minimal_polynomial()), xoshiro256_step);
+        }
+        
+        /**
+         * Advance a xoshiro256 state by times * 2^128 steps, in O(log times).
+         */
+        inline void xoshiro256_jump(std::uint64_t (&state)[4], unsigned long long times) {
+            if (times == 1) {
+                return xoshiro256_jump(state, xoshiro256_jump_polynomial);
+            }
+            const gf2_polynomial jump(std::begin(xoshiro256_jump_polynomial), std::end(xoshiro256_jump_polynomial));
+            gf2_jump(state, gf2_power_mod(jump, times, xoshiro256_minimal_polynomial()), xoshiro256_step);
+        }
+    }
+    
+    /**
+     * Small-state engines which satisfy the UniformRandomBitGenerator
+     * requirements, and may be used wherever std::mt19937_64 is.
+     */
+    namespace engines {
+        /**
+         * splitmix64 (Steele, Lea, Flood): 64 bits of state, one
+         * addition and a mixing function per output. Mostly useful
+         * to seed the other engines.
+         */
+        class splitmix64 {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 0x853c49e6748fea9bULL;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit splitmix64(result_type seed = default_seed) noexcept : state_{seed} {}
+            
+            void seed(result_type seed = default_seed) noexcept { state_ = seed; }
+            
+            result_type operator()() noexcept {
+                return details::mix64(state_ += 0x9e3779b97f4a7c15ULL);
+            }
+            
+            void discard(unsigned long long n) noexcept {
+                state_ += 0x9e3779b97f4a7c15ULL * n;
+            }
+            
+            friend bool operator==(const splitmix64& lhs, const splitmix64& rhs) noexcept {
+                return lhs.state_ == rhs.state_;
+            }
+            
+            friend bool operator!=(const splitmix64& lhs, const splitmix64& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            std::uint64_t state_;
+        };
+        
+        /**
+         * xoshiro256** (Blackman, Vigna): 256 bits of state, all-purpose
+         * generator with excellent speed and statistical quality.
+         */
+        class xoshiro256starstar {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = splitmix64::default_seed;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit xoshiro256starstar(result_type seed = default_seed) noexcept { this->seed(seed); }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, xoshiro256starstar>::value, int>::type = 0>
+            explicit xoshiro256starstar(SeedSequence& seq) { this->seed(seq); }
+            
+            /**
+             * The state is expanded from the seed with splitmix64, as
+             * recommended by the authors, so that it is never all zero.
+             */
+            void seed(result_type seed = default_seed) noexcept {
+                auto seeder = splitmix64{seed};
+                for (auto& word : state_) {
+                    word = seeder();
+                }
+            }
+            
+            /**
+             * Seed the whole 256 bits state from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, xoshiro256starstar>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                details::xoshiro256_seed(state_, seq);
+            }
+            
+            result_type operator()() noexcept {
+                const auto result = details::rotl(state_[1] * 5, 7) * 9;
+                details::xoshiro256_step(state_);
+                return result;
+            }
+            
+            void discard(unsigned long long n) {
+                discard_fast(n);
+            }
+            
+            /**
+             * Skip n outputs in O(log n).
+             */
+            void discard_fast(unsigned long long n) {
+                details::xoshiro256_discard(state_, n);
+            }
+            
+            /**
+             * Advance the state by 2^128 steps: each jump starts a new
+             * stream, which does not overlap the previous ones for 2^128
+             * outputs, e.g. one per thread.
+             */
+            void jump() noexcept {
+                details::xoshiro256_jump(state_, details::xoshiro256_jump_polynomial);
+            }
+            
+            /**
+             * Advance the state by times * 2^128 steps, in O(log times).
+             */
+            void jump(unsigned long long times) {
+                details::xoshiro256_jump(state_, times);
+            }
+            
+            /**
+             * Advance the state by 2^192 steps: each long jump starts
+             * 2^64 new streams for jump().
+             */
+            void long_jump() noexcept {
+                details::xoshiro256_jump(state_, details::xoshiro256_long_jump_polynomial);
+            }
+            
+            friend bool operator==(const xoshiro256starstar& lhs, const xoshiro256starstar& rhs) noexcept {
+                return lhs.state_[0] == rhs.state_[0] && lhs.state_[1] == rhs.state_[1]
+                    && lhs.state_[2] == rhs.state_[2] && lhs.state_[3] == rhs.state_[3];
+            }
+            
+            friend bool operator!=(const xoshiro256starstar& lhs, const xoshiro256starstar& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            std::uint64_t state_[4];
+        };
+        
+        /**
+         * xoshiro256+ (Blackman, Vigna): the fastest of the xoshiro256
+         * generators, for floating point numbers, which only use the
+         * high bits. The lowest bits have a low linear complexity.
+         */
+        class xoshiro256plus {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = splitmix64::default_seed;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit xoshiro256plus(result_type seed = default_seed) noexcept { this->seed(seed); }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, xoshiro256plus>::value, int>::type = 0>
+            explicit xoshiro256plus(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed) noexcept {
+                auto seeder = splitmix64{seed};
+                for (auto& word : state_) {
+                    word = seeder();
+                }
+            }
+            
+            /**
+             * Seed the whole 256 bits state from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, xoshiro256plus>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                details::xoshiro256_seed(state_, seq);
+            }
+            
+            result_type operator()() noexcept {
+                const auto result = state_[0] + state_[3];
+                details::xoshiro256_step(state_);
+                return result;
+            }
+            
+            void discard(unsigned long long n) {
+                discard_fast(n);
+            }
+            
+            /**
+             * Skip n outputs in O(log n).
+             */
+            void discard_fast(unsigned long long n) {
+                details::xoshiro256_discard(state_, n);
+            }
+            
+            /**
+             * Advance the state by 2^128 steps: each jump starts a new
+             * stream, which does not overlap the previous ones for 2^128
+             * outputs, e.g. one per thread.
+             */
+            void jump() noexcept {
+                details::xoshiro256_jump(state_, details::xoshiro256_jump_polynomial);
+            }
+            
+            /**
+             * Advance the state by times * 2^128 steps, in O(log times).
+             */
+            void jump(unsigned long long times) {
+                details::xoshiro256_jump(state_, times);
+            }
+            
+            /**
+             * Advance the state by 2^192 steps: each long jump starts
+             * 2^64 new streams for jump().
+             */
+            void long_jump() noexcept {
+                details::xoshiro256_jump(state_, details::xoshiro256_long_jump_polynomial);
+            }
+            
+            friend bool operator==(const xoshiro256plus& lhs, const xoshiro256plus& rhs) noexcept {
+                return lhs.state_[0] == rhs.state_[0] && lhs.state_[1] == rhs.state_[1]
+                    && lhs.state_[2] == rhs.state_[2] && lhs.state_[3] == rhs.state_[3];
+            }
+            
+            friend bool operator!=(const xoshiro256plus& lhs, const xoshiro256plus& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            std::uint64_t state_[4];
+        };
+        
+        /**
+         * Lanes independent xoshiro256+ generators advanced together in
+         * vector registers (4 lanes fill an AVX2 register, 8 an AVX-512 one).
+         * Lane 0 is seeded as xoshiro256plus{seed}, and lane l+1 is lane l
+         * jumped by 2^128 steps, so that the lanes never overlap: lane l
+         * produces the same stream as xoshiro256plus{seed} after l calls to
+         * jump(). The outputs are interleaved: one output of each lane, in
+         * order, then the next step.
+         */
+        template <std::size_t Lanes>
+        class xoshiro256plus_lanes {
+            static_assert(Lanes == 4 || Lanes == 8 || Lanes == 16, "the number of lanes must be 4, 8 or 16");
+            
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = splitmix64::default_seed;
+            
+            static constexpr std::size_t lanes = Lanes;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit xoshiro256plus_lanes(result_type seed = default_seed) noexcept { this->seed(seed); }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, xoshiro256plus_lanes>::value, int>::type = 0>
+            explicit xoshiro256plus_lanes(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed) noexcept {
+                std::uint64_t lane[4];
+                auto seeder = splitmix64{seed};
+                for (auto& word : lane) {
+                    word = seeder();
+                }
+                seed_lanes(lane);
+            }
+            
+            /**
+             * Seed lane 0 from a seed sequence, the other lanes being
+             * jumped from it as usual.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, xoshiro256plus_lanes>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                std::uint64_t lane[4];
+                details::xoshiro256_seed(lane, seq);
+                seed_lanes(lane);
+            }
+            
+            result_type operator()() noexcept {
+                if (index_ == Lanes) {
+                    details::xoshiro256plus_lanes<Lanes>(state_, output_, 1);
+                    index_ = 0;
+                }
+                return output_[index_++];
+            }
+            
+            void discard(unsigned long long n) noexcept {
+                while (n--) {
+                    (*this)();
+                }
+            }
+            
+            /**
+             * Skip n outputs in O(log n): all the lanes jump by the same
+             * number of steps.
+             */
+            void discard_fast(unsigned long long n) {
+                while (n != 0 && index_ != Lanes) {
+                    (*this)();
+                    --n;
+                }
+                const auto steps = n / Lanes;
+                if (steps < 256) {
+                    for (auto i = steps; i != 0; --i) {
+                        details::xoshiro256plus_lanes<Lanes>(state_, output_, 1);
+                    }
+                } else {
+                    const auto jump = details::gf2_x_power_mod(steps, details::xoshiro256_minimal_polynomial());
+                    for (std::size_t l = 0; l < Lanes; ++l) {
+                        std::uint64_t lane[4];
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            lane[i] = state_[i * Lanes + l];
+                        }
+                        details::gf2_jump(lane, jump, details::xoshiro256_step);
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            state_[i * Lanes + l] = lane[i];
+                        }
+                    }
+                }
+                for (n %= Lanes; n != 0; --n) {
+                    (*this)();
+                }
+            }
+            
+            /**
+             * Write the next count outputs, a whole step of all the
+             * lanes at a time.
+             */
+            void generate_block(std::uint64_t* first, std::size_t count) noexcept {
+                while (count != 0 && index_ != Lanes) {
+                    *first++ = (*this)();
+                    --count;
+                }
+                const auto steps = count / Lanes;
+                details::xoshiro256plus_lanes<Lanes>(state_, first, steps);
+                first += steps * Lanes;
+                count -= steps * Lanes;
+                while (count-- != 0) {
+                    *first++ = (*this)();
+                }
+            }
+            
+            friend bool operator==(const xoshiro256plus_lanes& lhs, const xoshiro256plus_lanes& rhs) noexcept {
+                return std::equal(lhs.state_, lhs.state_ + 4 * Lanes, rhs.state_)
+                    && lhs.index_ == rhs.index_
+                    && std::equal(lhs.output_ + lhs.index_, lhs.output_ + Lanes, rhs.output_ + rhs.index_);
+            }
+            
+            friend bool operator!=(const xoshiro256plus_lanes& lhs, const xoshiro256plus_lanes& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            /**
+             * Lane l is the given state jumped l times.
+             */
+            void seed_lanes(std::uint64_t (&lane)[4]) noexcept {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    if (l != 0) {
+                        details::xoshiro256_jump(lane, details::xoshiro256_jump_polynomial);
+                    }
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        state_[i * Lanes + l] = lane[i];
+                    }
+                }
+                index_ = Lanes;
+            }
+            
+            std::uint64_t state_[4 * Lanes];
+            std::uint64_t output_[Lanes];
+            std::size_t index_;
+        };
+        
+        /**
+         * PCG64 (O'Neill): 128 bits linear congruential generator with
+         * the XSL-RR output permutation.
+         */
+        class pcg64 {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 0xcafef00dd15ea5e5ULL;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit pcg64(result_type seed = default_seed) noexcept { this->seed(seed); }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, pcg64>::value, int>::type = 0>
+            explicit pcg64(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed) noexcept {
+                state_hi_ = 0;
+                state_lo_ = 0;
+                step();
+                state_lo_ += seed;
+                state_hi_ += (state_lo_ < seed);
+                step();
+            }
+            
+            /**
+             * Seed the whole 128 bits state from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, pcg64>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                std::uint64_t state[2];
+                details::seed_words(seq, state);
+                state_lo_ = state[0];
+                state_hi_ = state[1];
+            }
+            
+            result_type operator()() noexcept {
+                step();
+                return details::rotr(state_hi_ ^ state_lo_, static_cast<int>(state_hi_ >> 58));
+            }
+            
+            void discard(unsigned long long n) noexcept {
+                discard_fast(n);
+            }
+            
+            /**
+             * Skip n outputs in O(log n): the LCG jumps ahead by
+             * exponentiation of its affine transition (Brown, "Random
+             * Number Generation with Arbitrary Strides", 1994).
+             */
+            void discard_fast(unsigned long long n) noexcept {
+                std::uint64_t acc_mult_hi = 0, acc_mult_lo = 1, acc_plus_hi = 0, acc_plus_lo = 0;
+                std::uint64_t cur_mult_hi = multiplier_hi, cur_mult_lo = multiplier_lo;
+                std::uint64_t cur_plus_hi = increment_hi, cur_plus_lo = increment_lo;
+                for (; n != 0; n >>= 1) {
+                    if (n & 1) {
+                        multiply(acc_mult_hi, acc_mult_lo, cur_mult_hi, cur_mult_lo);
+                        multiply(acc_plus_hi, acc_plus_lo, cur_mult_hi, cur_mult_lo);
+                        add(acc_plus_hi, acc_plus_lo, cur_plus_hi, cur_plus_lo);
+                    }
+                    // plus = (mult + 1) * plus, mult = mult^2
+                    auto factor_hi = cur_mult_hi, factor_lo = cur_mult_lo;
+                    add(factor_hi, factor_lo, 0, 1);
+                    multiply(cur_plus_hi, cur_plus_lo, factor_hi, factor_lo);
+                    multiply(cur_mult_hi, cur_mult_lo, cur_mult_hi, cur_mult_lo);
+                }
+                multiply(state_hi_, state_lo_, acc_mult_hi, acc_mult_lo);
+                add(state_hi_, state_lo_, acc_plus_hi, acc_plus_lo);
+            }
+            
+            friend bool operator==(const pcg64& lhs, const pcg64& rhs) noexcept {
+                return lhs.state_hi_ == rhs.state_hi_ && lhs.state_lo_ == rhs.state_lo_;
+            }
+            
+            friend bool operator!=(const pcg64& lhs, const pcg64& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            static constexpr std::uint64_t multiplier_hi = 0x2360ed051fc65da4ULL;
+            static constexpr std::uint64_t multiplier_lo = 0x4385df649fccf645ULL;
+            static constexpr std::uint64_t increment_hi = 0x5851f42d4c957f2dULL;
+            static constexpr std::uint64_t increment_lo = 0x14057b7ef767814fULL;
+            
+            /**
+             * state = state * multiplier + increment (mod 2^128).
+             */
+            void step() noexcept {
+                std::uint64_t hi;
+                const auto lo = details::umul128(state_lo_, multiplier_lo, hi);
+                hi += state_lo_ * multiplier_hi + state_hi_ * multiplier_lo;
+                state_lo_ = lo + increment_lo;
+                state_hi_ = hi + increment_hi + (state_lo_ < lo);
+            }
+            
+            /**
+             * a = a * b (mod 2^128).
+             */
+            static void multiply(std::uint64_t& a_hi, std::uint64_t& a_lo, std::uint64_t b_hi, std::uint64_t b_lo) noexcept {
+                std::uint64_t hi;
+                const auto lo = details::umul128(a_lo, b_lo, hi);
+                a_hi = hi + a_lo * b_hi + a_hi * b_lo;
+                a_lo = lo;
+            }
+            
+            /**
+             * a = a + b (mod 2^128).
+             */
+            static void add(std::uint64_t& a_hi, std::uint64_t& a_lo, std::uint64_t b_hi, std::uint64_t b_lo) noexcept {
+                a_lo += b_lo;
+                a_hi += b_hi + (a_lo < b_lo);
+            }
+            
+            std::uint64_t state_hi_;
+            std::uint64_t state_lo_;
+        };
+        
+        /**
+         * wyrand (Wang Yi): 64 bits of state, a counter scrambled by
+         * a single 128 bits multiplication. The fastest of the lot.
+         */
+        class wyrand {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = splitmix64::default_seed;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit wyrand(result_type seed = default_seed) noexcept : state_{seed} {}
+            
+            void seed(result_type seed = default_seed) noexcept { state_ = seed; }
+            
+            result_type operator()() noexcept {
+                state_ += 0xa0761d6478bd642fULL;
+                std::uint64_t hi;
+                const auto lo = details::umul128(state_, state_ ^ 0xe7037ed1a0b428dbULL, hi);
+                return lo ^ hi;
+            }
+            
+            void discard(unsigned long long n) noexcept {
+                state_ += 0xa0761d6478bd642fULL * n;
+            }
+            
+            friend bool operator==(const wyrand& lhs, const wyrand& rhs) noexcept {
+                return lhs.state_ == rhs.state_;
+            }
+            
+            friend bool operator!=(const wyrand& lhs, const wyrand& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            std::uint64_t state_;
+        };
+        
+        /**
+         * SFMT19937 (Saito, Matsumoto, 2006): a SIMD-oriented Mersenne
+         * Twister of period 2^19937 - 1, whose state is regenerated all
+         * at once, with SSE2 when available, then given out word by word.
+         * The outputs are the 64 bits words of the state, as gen_rand64
+         * of the reference implementation.
+         */
+        class sfmt19937_64 {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 5489u;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit sfmt19937_64(result_type seed = default_seed) noexcept { this->seed(seed); }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, sfmt19937_64>::value, int>::type = 0>
+            explicit sfmt19937_64(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed) noexcept {
+                auto x = details::mt_seed32(seed);
+                state_[0] = x;
+                for (std::uint32_t i = 1; i < size32; ++i) {
+                    x = 1812433253U * (x ^ (x >> 30)) + i;
+                    state_[i] = x;
+                }
+                certify();
+            }
+            
+            /**
+             * Seed the whole 19937 bits state from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, sfmt19937_64>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                seq.generate(state_, state_ + size32);
+                certify();
+            }
+            
+            result_type operator()() noexcept {
+                if (index_ == size64) {
+                    refill();
+                }
+                const auto i = index_++;
+                return state_[2 * i] | (static_cast<std::uint64_t>(state_[2 * i + 1]) << 32);
+            }
+            
+            void discard(unsigned long long n) noexcept {
+                while (n != 0) {
+                    if (index_ == size64) {
+                        refill();
+                    }
+                    const auto step = std::min<unsigned long long>(n, size64 - index_);
+                    index_ += static_cast<std::size_t>(step);
+                    n -= step;
+                }
+            }
+            
+            /**
+             * Skip n outputs in O(log n), jumping over whole state
+             * regenerations with the minimal polynomial of the recursion.
+             * The polynomial is computed on first use, and only pays off
+             * for jumps of more than a few million outputs.
+             */
+            void discard_fast(unsigned long long n) {
+                const auto buffered = size64 - index_;
+                if (n <= buffered) {
+                    index_ += static_cast<std::size_t>(n);
+                    return;
+                }
+                n -= buffered;
+                const auto regenerations = n / size64 + 1;
+                if (regenerations < 256 * details::sfmt19937_params::n) {
+                    for (auto i = regenerations; i != 0; --i) {
+                        details::sfmt19937_generate(state_);
+                    }
+                } else {
+                    const auto jump = details::gf2_x_power_mod(regenerations, details::sfmt19937_minimal_polynomial());
+                    details::gf2_jump(state_, jump, details::sfmt19937_generate);
+                }
+                index_ = static_cast<std::size_t>(n % size64);
+            }
+            
+            /**
+             * Write the next count outputs, straight from the state.
+             */
+            void generate_block(std::uint64_t* first, std::size_t count) noexcept {
+                while (count != 0) {
+                    if (index_ == size64) {
+                        refill();
+                    }
+                    const auto step = std::min(count, size64 - index_);
+                    for (std::size_t i = 0; i < step; ++i) {
+                        const auto j = index_ + i;
+                        first[i] = state_[2 * j] | (static_cast<std::uint64_t>(state_[2 * j + 1]) << 32);
+                    }
+                    index_ += step;
+                    first += step;
+                    count -= step;
+                }
+            }
+            
+            friend bool operator==(const sfmt19937_64& lhs, const sfmt19937_64& rhs) noexcept {
+                return lhs.index_ == rhs.index_ && std::equal(lhs.state_, lhs.state_ + size32, rhs.state_);
+            }
+            
+            friend bool operator!=(const sfmt19937_64& lhs, const sfmt19937_64& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            static constexpr std::size_t size32 = 4 * details::sfmt19937_params::n;
+            static constexpr std::size_t size64 = size32 / 2;
+            
+            /**
+             * Period certification: the state must not lie in the
+             * subspace of shorter period.
+             */
+            void certify() noexcept {
+                using params = details::sfmt19937_params;
+                auto inner = (state_[0] & params::parity1) ^ (state_[3] & params::parity4);
+                for (int shift = 16; shift > 0; shift /= 2) {
+                    inner ^= inner >> shift;
+                }
+                if ((inner & 1) == 0) {
+                    state_[0] ^= 1;
+                }
+                index_ = size64;
+            }
+            
+            void refill() noexcept {
+                details::sfmt19937_generate(state_);
+                index_ = 0;
+            }
+            
+            alignas(16) std::uint32_t state_[size32];
+            std::size_t index_;
+        };
+        
+        /**
+         * dSFMT19937 (Saito, Matsumoto, 2009): the double precision
+         * variant of SFMT, whose state words are directly doubles in
+         * [1, 2). close1_open2 and fill_close1_open2 give them out, and
+         * are used by the floating point uniform distributions; as a
+         * UniformRandomBitGenerator, it returns their 52 mantissa bits.
+         */
+        class dsfmt19937 {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 5489u;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return mantissa; }
+            
+            explicit dsfmt19937(result_type seed = default_seed) noexcept { this->seed(seed); }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, dsfmt19937>::value, int>::type = 0>
+            explicit dsfmt19937(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed) noexcept {
+                // The 32 bits initialization covers the lung as well
+                auto x = details::mt_seed32(seed);
+                for (std::uint32_t i = 0; i < 2 * size64 + 4; ++i) {
+                    if (i != 0) {
+                        x = 1812433253U * (x ^ (x >> 30)) + i;
+                    }
+                    auto& word = state_[i / 2];
+                    word = i % 2 == 0 ? x : word | (static_cast<std::uint64_t>(x) << 32);
+                }
+                certify();
+            }
+            
+            /**
+             * Seed the whole state, lung included, from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, dsfmt19937>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                details::seed_words(seq, state_);
+                certify();
+            }
+            
+            result_type operator()() noexcept {
+                return next() & mantissa;
+            }
+            
+            /**
+             * @return - a random double in [1, 2).
+             */
+            double close1_open2() noexcept {
+                return to_double(next());
+            }
+            
+            /**
+             * Write the next count doubles in [1, 2).
+             */
+            void fill_close1_open2(double* first, std::size_t count) noexcept {
+                while (count != 0) {
+                    if (index_ == size64) {
+                        refill();
+                    }
+                    const auto step = std::min(count, size64 - index_);
+                    std::memcpy(first, state_ + index_, step * sizeof(double));
+                    index_ += step;
+                    first += step;
+                    count -= step;
+                }
+            }
+            
+            void discard(unsigned long long n) noexcept {
+                while (n != 0) {
+                    if (index_ == size64) {
+                        refill();
+                    }
+                    const auto step = std::min<unsigned long long>(n, size64 - index_);
+                    index_ += static_cast<std::size_t>(step);
+                    n -= step;
+                }
+            }
+            
+            /**
+             * Skip n outputs in O(log n), jumping over whole state
+             * regenerations with the minimal polynomial of the recursion.
+             * The polynomial is computed on first use, and only pays off
+             * for jumps of more than a few million outputs.
+             */
+            void discard_fast(unsigned long long n) {
+                const auto buffered = size64 - index_;
+                if (n <= buffered) {
+                    index_ += static_cast<std::size_t>(n);
+                    return;
+                }
+                n -= buffered;
+                const auto regenerations = n / size64 + 1;
+                if (regenerations < 256 * details::dsfmt19937_params::n) {
+                    for (auto i = regenerations; i != 0; --i) {
+                        details::dsfmt19937_generate(state_);
+                    }
+                } else {
+                    const auto jump = details::gf2_x_power_mod(regenerations, details::dsfmt19937_minimal_polynomial());
+                    details::gf2_jump(state_, jump, details::dsfmt19937_generate);
+                }
+                index_ = static_cast<std::size_t>(n % size64);
+            }
+            
+            friend bool operator==(const dsfmt19937& lhs, const dsfmt19937& rhs) noexcept {
+                return lhs.index_ == rhs.index_ && std::equal(lhs.state_, lhs.state_ + size64 + 2, rhs.state_);
+            }
+            
+            friend bool operator!=(const dsfmt19937& lhs, const dsfmt19937& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            static constexpr std::size_t size64 = 2 * details::dsfmt19937_params::n;
+            static constexpr std::uint64_t mantissa = 0x000fffffffffffffULL;
+            static constexpr std::uint64_t one = 0x3ff0000000000000ULL;
+            
+            static double to_double(std::uint64_t bits) noexcept {
+                double value;
+                std::memcpy(&value, &bits, sizeof value);
+                return value;
+            }
+            
+            std::uint64_t next() noexcept {
+                if (index_ == size64) {
+                    refill();
+                }
+                return state_[index_++];
+            }
+            
+            /**
+             * Turn the state words into doubles in [1, 2), then certify
+             * the period: the lung must not lie in the subspace of
+             * shorter period.
+             */
+            void certify() noexcept {
+                using params = details::dsfmt19937_params;
+                for (std::size_t i = 0; i < size64; ++i) {
+                    state_[i] = (state_[i] & mantissa) | one;
+                }
+                auto inner = ((state_[size64] ^ params::fix1) & params::pcv1) ^ ((state_[size64 + 1] ^ params::fix2) & params::pcv2);
+                for (int shift = 32; shift > 0; shift /= 2) {
+                    inner ^= inner >> shift;
+                }
+                if ((inner & 1) == 0) {
+                    state_[size64 + 1] ^= 1;
+                }
+                index_ = size64;
+            }
+            
+            void refill() noexcept {
+                details::dsfmt19937_generate(state_);
+                index_ = 0;
+            }
+            
+            // n 128 bits words, then the lung
+            alignas(16) std::uint64_t state_[size64 + 2];
+            std::size_t index_;
+        };
+        
+        /**
+         * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy
+         * as 1, 2, 3", 2011): a counter-based engine, each output block is
+         * a keyed bijection of its index. Hence, discard is O(1), and the
+         * streams identified by (seed, stream) are trivially independent.
+         * Each 128 bits block provides two 64 bits outputs, (x1, x0) then
+         * (x3, x2); the block index is the low half of the counter and the
+         * stream its high half.
+         */
+        class philox4x32 {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 0;
+            
+            /**
+             * Number of counters processed together by generate_block.
+             */
+            static constexpr std::size_t lanes = 8;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit philox4x32(result_type seed = default_seed, std::uint64_t stream = 0) noexcept {
+                this->seed(seed, stream);
+            }
+            
+            void seed(result_type seed = default_seed, std::uint64_t stream = 0) noexcept {
+                key_[0] = static_cast<std::uint32_t>(seed);
+                key_[1] = static_cast<std::uint32_t>(seed >> 32);
+                stream_ = stream;
+                position_ = 0;
+                index_ = 2;
+            }
+            
+            result_type operator()() noexcept {
+                if (index_ == 2) {
+                    blocks<1>(key_, position_++, stream_, output_);
+                    index_ = 0;
+                }
+                return output_[index_++];
+            }
+            
+            /**
+             * Skip n outputs in constant time.
+             */
+            void discard(unsigned long long n) noexcept {
+                const auto buffered = 2u - index_;
+                if (n < buffered) {
+                    index_ += static_cast<unsigned>(n);
+                    return;
+                }
+                n -= buffered;
+                position_ += n / 2;
+                index_ = 2;
+                if (n % 2 != 0) {
+                    (*this)();
+                }
+            }
+            
+            /**
+             * Write the next count outputs, computing lanes blocks at once
+             * in a loop that the compiler vectorizes.
+             */
+            void generate_block(std::uint64_t* first, std::size_t count) noexcept {
+                while (count != 0 && index_ != 2) {
+                    *first++ = (*this)();
+                    --count;
+                }
+                for (; count >= 2 * lanes; count -= 2 * lanes, first += 2 * lanes) {
+                    blocks<lanes>(key_, position_, stream_, first);
+                    position_ += lanes;
+                }
+                while (count-- != 0) {
+                    *first++ = (*this)();
+                }
+            }
+            
+            /**
+             * Compute Lanes consecutive blocks, starting at position.
+             */
+            template <std::size_t Lanes>
+            static void blocks(const std::uint32_t (&key)[2], std::uint64_t position, std::uint64_t stream,
+                               std::uint64_t* output) noexcept {
+                std::uint32_t x0[Lanes], x1[Lanes], x2[Lanes], x3[Lanes];
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    x0[l] = static_cast<std::uint32_t>(position + l);
+                    x1[l] = static_cast<std::uint32_t>((position + l) >> 32);
+                    x2[l] = static_cast<std::uint32_t>(stream);
+                    x3[l] = static_cast<std::uint32_t>(stream >> 32);
+                }
+                
+                auto k0 = key[0];
+                auto k1 = key[1];
+                for (int round = 0; round < 10; ++round) {
+                    for (std::size_t l = 0; l < Lanes; ++l) {
+                        const auto p0 = std::uint64_t{0xd2511f53} * x0[l];
+                        const auto p1 = std::uint64_t{0xcd9e8d57} * x2[l];
+                        x0[l] = static_cast<std::uint32_t>(p1 >> 32) ^ x1[l] ^ k0;
+                        x1[l] = static_cast<std::uint32_t>(p1);
+                        x2[l] = static_cast<std::uint32_t>(p0 >> 32) ^ x3[l] ^ k1;
+                        x3[l] = static_cast<std::uint32_t>(p0);
+                    }
+                    k0 += 0x9e3779b9;
+                    k1 += 0xbb67ae85;
+                }
+                
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    output[2 * l] = (static_cast<std::uint64_t>(x1[l]) << 32) | x0[l];
+                    output[2 * l + 1] = (static_cast<std::uint64_t>(x3[l]) << 32) | x2[l];
+                }
+            }
+            
+            friend bool operator==(const philox4x32& lhs, const philox4x32& rhs) noexcept {
+                return lhs.key_[0] == rhs.key_[0] && lhs.key_[1] == rhs.key_[1] && lhs.stream_ == rhs.stream_
+                    && lhs.position_ == rhs.position_ && lhs.index_ == rhs.index_;
+            }
+            
+            friend bool operator!=(const philox4x32& lhs, const philox4x32& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            std::uint32_t key_[2];
+            std::uint64_t stream_;
+            std::uint64_t position_;
+            std::uint64_t output_[2];
+            unsigned index_;
+        };
+        
+        /**
+         * Threefry4x64-20 (Salmon et al.): the counter-based engine built
+         * on the Threefish block cipher, with additions, rotations and xors
+         * only. The key is (seed, stream, 0, 0), and each 256 bits block
+         * provides four 64 bits outputs.
+         */
+        class threefry4x64 {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 0;
+            
+            /**
+             * Number of counters processed together by generate_block.
+             */
+            static constexpr std::size_t lanes = 4;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit threefry4x64(result_type seed = default_seed, std::uint64_t stream = 0) noexcept {
+                this->seed(seed, stream);
+            }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, threefry4x64>::value, int>::type = 0>
+            explicit threefry4x64(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed, std::uint64_t stream = 0) noexcept {
+                key_[0] = seed;
+                key_[1] = stream;
+                key_[2] = 0;
+                key_[3] = 0;
+                position_ = 0;
+                index_ = 4;
+            }
+            
+            /**
+             * Seed the whole 256 bits key from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, threefry4x64>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                details::seed_words(seq, key_);
+                position_ = 0;
+                index_ = 4;
+            }
+            
+            result_type operator()() noexcept {
+                if (index_ == 4) {
+                    blocks<1>(key_, position_++, output_);
+                    index_ = 0;
+                }
+                return output_[index_++];
+            }
+            
+            /**
+             * Skip n outputs in constant time.
+             */
+            void discard(unsigned long long n) noexcept {
+                const auto buffered = 4u - index_;
+                if (n < buffered) {
+                    index_ += static_cast<unsigned>(n);
+                    return;
+                }
+                n -= buffered;
+                position_ += n / 4;
+                index_ = 4;
+                if (n % 4 != 0) {
+                    (*this)();
+                    index_ = static_cast<unsigned>(n % 4);
+                }
+            }
+            
+            /**
+             * Write the next count outputs, computing lanes blocks at once
+             * in a loop that the compiler vectorizes.
+             */
+            void generate_block(std::uint64_t* first, std::size_t count) noexcept {
+                while (count != 0 && index_ != 4) {
+                    *first++ = (*this)();
+                    --count;
+                }
+                for (; count >= 4 * lanes; count -= 4 * lanes, first += 4 * lanes) {
+                    blocks<lanes>(key_, position_, first);
+                    position_ += lanes;
+                }
+                while (count-- != 0) {
+                    *first++ = (*this)();
+                }
+            }
+            
+            /**
+             * Compute Lanes consecutive blocks, starting at position.
+             */
+            template <std::size_t Lanes>
+            static void blocks(const std::uint64_t (&key)[4], std::uint64_t position, std::uint64_t* output) noexcept {
+                const std::uint64_t schedule[5] = {
+                    key[0], key[1], key[2], key[3], 0x1bd11bdaa9fc1a22ULL ^ key[0] ^ key[1] ^ key[2] ^ key[3]
+                };
+                
+                std::uint64_t x0[Lanes], x1[Lanes], x2[Lanes], x3[Lanes];
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    x0[l] = position + l + schedule[0];
+                    x1[l] = schedule[1];
+                    x2[l] = schedule[2];
+                    x3[l] = schedule[3];
+                }
+                
+                // 20 rounds, with a key injection every 4 rounds
+                for (std::uint64_t s = 1; s <= 5; ++s) {
+                    if (s % 2 != 0) {
+                        rounds<Lanes, 14, 16, 52, 57>(x0, x1, x2, x3);
+                        rounds<Lanes, 23, 40, 5, 37>(x0, x1, x2, x3);
+                    } else {
+                        rounds<Lanes, 25, 33, 46, 12>(x0, x1, x2, x3);
+                        rounds<Lanes, 58, 22, 32, 32>(x0, x1, x2, x3);
+                    }
+                    for (std::size_t l = 0; l < Lanes; ++l) {
+                        x0[l] += schedule[s % 5];
+                        x1[l] += schedule[(s + 1) % 5];
+                        x2[l] += schedule[(s + 2) % 5];
+                        x3[l] += schedule[(s + 3) % 5] + s;
+                    }
+                }
+                
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    output[4 * l] = x0[l];
+                    output[4 * l + 1] = x1[l];
+                    output[4 * l + 2] = x2[l];
+                    output[4 * l + 3] = x3[l];
+                }
+            }
+            
+            friend bool operator==(const threefry4x64& lhs, const threefry4x64& rhs) noexcept {
+                return std::equal(std::begin(lhs.key_), std::end(lhs.key_), std::begin(rhs.key_))
+                    && lhs.position_ == rhs.position_ && lhs.index_ == rhs.index_;
+            }
+            
+            friend bool operator!=(const threefry4x64& lhs, const threefry4x64& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            /**
+             * Two rounds of Threefry4x64, with constant rotations so that
+             * they compile to shifts, or to vector rotations.
+             */
+            template <std::size_t Lanes, int A, int B, int C, int D>
+            static void rounds(std::uint64_t (&x0)[Lanes], std::uint64_t (&x1)[Lanes],
+                               std::uint64_t (&x2)[Lanes], std::uint64_t (&x3)[Lanes]) noexcept {
+                for (std::size_t l = 0; l < Lanes; ++l) {
+                    x0[l] += x1[l]; x1[l] = details::rotl(x1[l], A) ^ x0[l];
+                    x2[l] += x3[l]; x3[l] = details::rotl(x3[l], B) ^ x2[l];
+                    x0[l] += x3[l]; x3[l] = details::rotl(x3[l], C) ^ x0[l];
+                    x2[l] += x1[l]; x1[l] = details::rotl(x1[l], D) ^ x2[l];
+                }
+            }
+            
+            std::uint64_t key_[4];
+            std::uint64_t position_;
+            std::uint64_t output_[4];
+            unsigned index_;
+        };
+        
+        /**
+         * ChaCha with Rounds rounds (Bernstein, 2008), the stream cipher of
+         * RFC 8439, as a cryptographically secure engine: its outputs are
+         * the keystream of a 256 bits key, read as little endian 64 bits
+         * words. Like the other counter-based engines, it takes a stream
+         * index, the 64 bits nonce of the original ChaCha, and skips ahead
+         * in constant time. ChaCha20 is the conservative choice, ChaCha12
+         * and ChaCha8 trade security margin for speed.
+         * A 64 bits seed is expanded into the key with splitmix64, which
+         * cannot be more secure than the seed: secrets require a 256 bits
+         * key from a secure source, e.g. std::random_device.
+         */
+        template <int Rounds>
+        class chacha {
+            static_assert(Rounds == 8 || Rounds == 12 || Rounds == 20, "ChaCha is defined with 8, 12 or 20 rounds");
+            
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type default_seed = 0;
+            
+            /**
+             * Number of blocks computed together, of 8 outputs each.
+             */
+            static constexpr std::size_t lanes = 16;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            explicit chacha(result_type seed = default_seed, std::uint64_t stream = 0) noexcept {
+                this->seed(seed, stream);
+            }
+            
+            explicit chacha(const std::uint32_t (&key)[8], std::uint64_t stream = 0) noexcept {
+                this->seed(key, stream);
+            }
+            
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, chacha>::value, int>::type = 0>
+            explicit chacha(SeedSequence& seq) { this->seed(seq); }
+            
+            void seed(result_type seed = default_seed, std::uint64_t stream = 0) noexcept {
+                for (std::size_t i = 0; i < 4; ++i) {
+                    const auto word = details::mix64(seed + (i + 1) * 0x9e3779b97f4a7c15ULL);
+                    key_[2 * i] = static_cast<std::uint32_t>(word);
+                    key_[2 * i + 1] = static_cast<std::uint32_t>(word >> 32);
+                }
+                reset(stream);
+            }
+            
+            void seed(const std::uint32_t (&key)[8], std::uint64_t stream = 0) noexcept {
+                for (std::size_t i = 0; i < 8; ++i) {
+                    key_[i] = key[i];
+                }
+                reset(stream);
+            }
+            
+            /**
+             * Seed the whole 256 bits key from a seed sequence.
+             */
+            template <typename SeedSequence, typename std::enable_if<details::is_seed_sequence<SeedSequence, chacha>::value, int>::type = 0>
+            void seed(SeedSequence& seq) {
+                seq.generate(key_, key_ + 8);
+                reset(0);
+            }
+            
+            result_type operator()() noexcept {
+                if (index_ == buffer_size) {
+                    refill();
+                }
+                return output_[index_++];
+            }
+            
+            /**
+             * Skip n outputs in constant time.
+             */
+            void discard(unsigned long long n) noexcept {
+                const auto buffered = buffer_size - index_;
+                if (n < buffered) {
+                    index_ += static_cast<std::size_t>(n);
+                    return;
+                }
+                n -= buffered;
+                position_ += n / 8;
+                index_ = buffer_size;
+                if (n % 8 != 0) {
+                    refill();
+                    index_ = static_cast<std::size_t>(n % 8);
+                }
+            }
+            
+            /**
+             * Write the next count outputs, computing lanes blocks at once
+             * with the best instruction set.
+             */
+            void generate_block(std::uint64_t* first, std::size_t count) noexcept {
+                while (count != 0 && index_ != buffer_size) {
+                    *first++ = (*this)();
+                    --count;
+                }
+                for (; count >= buffer_size; count -= buffer_size, first += buffer_size) {
+                    details::chacha_blocks<Rounds, lanes>(key_, position_, stream_, first);
+                    position_ += lanes;
+                }
+                while (count-- != 0) {
+                    *first++ = (*this)();
+                }
+            }
+            
+            friend bool operator==(const chacha& lhs, const chacha& rhs) noexcept {
+                return std::equal(std::begin(lhs.key_), std::end(lhs.key_), std::begin(rhs.key_))
+                    && lhs.stream_ == rhs.stream_ && lhs.offset() == rhs.offset();
+            }
+            
+            friend bool operator!=(const chacha& lhs, const chacha& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+            
+        private:
+            static constexpr std::size_t buffer_size = 8 * lanes;
+            
+            void reset(std::uint64_t stream) noexcept {
+                stream_ = stream;
+                position_ = 0;
+                index_ = buffer_size;
+            }
+            
+            /**
+             * @return - the index of the next output in the keystream, the
+             * buffer being filled or not.
+             */
+            std::uint64_t offset() const noexcept {
+                return 8 * position_ - (buffer_size - index_);
+            }
+            
+            /**
+             * Compute the lanes blocks following the buffer.
+             */
+            void refill() noexcept {
+                details::chacha_blocks<Rounds, lanes>(key_, position_, stream_, output_);
+                position_ += lanes;
+                index_ = 0;
+            }
+            
+            std::uint32_t key_[8];
+            std::uint64_t stream_;
+            std::uint64_t position_;
+            std::uint64_t output_[buffer_size];
+            std::size_t index_;
+        };
+        
+        using chacha8 = chacha<8>;
+        using chacha12 = chacha<12>;
+        using chacha20 = chacha<20>;
+        
+        /**
+         * Adaptor drawing an engine by blocks of Size words, declared here
+         * so that it may be the default engine, and defined with the bulk
+         * generation functions which it uses.
+         */
+        template <typename Engine, std::size_t Size = 256>
+        class buffered;
+        
+        /**
+         * Adaptor reading an engine from blocks generated in the
+         * background, declared here so that it may be the default engine.
+         */
+        template <typename Engine, std::size_t Size = 256, std::size_t Blocks = 8>
+        class prefetched;
+    }
+    
+    /**
+     * Engine used by rand and get_rand by default.
+     */
+    using default_engine = RANDOMIZE_DEFAULT_ENGINE;
+    
+    /**
+     * Tag requesting pooled draws of a small integral range: each 64
+     * bits word of the engine gives several of them, e.g. 64 coin flips,
+     * 23 dice rolls or 8 bytes, instead of one.
+     * Example: auto dice = randomize::get_rand(randomize::pooled, 1, 6).
+     */
+    struct pooled_policy {};
+    
+    constexpr pooled_policy pooled{};
+    
+    /**
+     * Counters of the cache of the distributions memoized by get_rand.
+     */
+    struct cache_statistics {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+        std::size_t size;
+        std::size_t capacity;
+    };
+    
+    namespace details {
+        /**
+         * Number of bytes which hold the value of an arithmetic type,
+         * without padding: the 80 bits x87 long double is stored in 12
+         * or 16 bytes.
+         */
+        template <typename T>
+        struct value_bytes : std::integral_constant<std::size_t, sizeof(T)> {};
+        
+        template <>
+        struct value_bytes<long double>
+            : std::integral_constant<std::size_t, std::numeric_limits<long double>::digits == 64 ? 10 : sizeof(long double)> {};
+        
+        /**
+         * Key of a range, made of the bit patterns of its bounds, so that
+         * e.g. two ranges of doubles within the unit interval, or ranges
+         * with a NaN bound, are told apart exactly, without conversion.
+         */
+        template <typename T>
+        struct range_key {
+            static constexpr std::size_t value_words = (value_bytes<T>::value + 7) / 8;
+            
+            range_key() = default;
+            
+            range_key(T min, T max) noexcept : words{} {
+                store(min, words);
+                store(max, words + value_words);
+            }
+            
+            /**
+             * @return - a 64 bits hash, each word going through the
+             * splitmix64 finalizer.
+             */
+            std::uint64_t hash() const noexcept {
+                std::uint64_t hash = 0;
+                for (const auto word : words) {
+                    hash = mix64(hash ^ word);
+                }
+                return hash;
+            }
+            
+            std::uint64_t words[2 * value_words];
+            
+        private:
+            /**
+             * A value which fits in a word is widened in a register, so
+             * that the word is not read back from two partial stores.
+             */
+            template <typename U, typename std::enable_if<(value_bytes<U>::value <= sizeof(std::uint64_t)), int>::type = 0>
+            static void store(U value, std::uint64_t* destination) noexcept {
+                std::uint64_t word = 0;
+                std::memcpy(&word, &value, value_bytes<U>::value);
+                *destination = word;
+            }
+            
+            template <typename U, typename std::enable_if<(value_bytes<U>::value > sizeof(std::uint64_t)), int>::type = 0>
+            static void store(U value, std::uint64_t* destination) noexcept {
+                std::memcpy(destination, &value, value_bytes<U>::value);
+            }
+        };
+        
+        /**
+         * Range structure for min/max type management.
+         */
+        template <typename T, typename TEnable = void>
+        struct range {};
+        
+        /**
+         * The default range for an integral type is simply
+         * its numeric limits.
+         */
+        template <typename T>
+        struct range<T, std::enable_if_t<std::is_integral<T>::value>> {
+            using type = T;
+            using value_type = T;
+            
+            static constexpr const T actual_min = std::numeric_limits<T>::min();
+            static constexpr const T actual_max = std::numeric_limits<T>::max();
+            
+            static constexpr const T min = std::numeric_limits<T>::min();
+            static constexpr const T max = std::numeric_limits<T>::max();
+        };
+        
+        /**
+         * Template parameters do not support floating-point
+         * numbers. Hence, its range is limited to the long long type.
+         */
+        template <typename T>
+        struct range<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+            using type = T;
+            using value_type = long long;
+            
+            static constexpr const T actual_min = std::numeric_limits<T>::min();
+            static constexpr const T actual_max = std::numeric_limits<T>::max();
+            
+            // Limitation: if you need a larger range, use the function parameter version
+            static constexpr const value_type min = std::numeric_limits<value_type>::min();
+            static constexpr const value_type max = std::numeric_limits<value_type>::max();
+        };
+        
+        /**
+         * Fill words with entropy from the operating system: a single
+         * getrandom system call on Linux, std::random_device elsewhere.
+         * The clock is the last resort, if both fail.
+         */
+        inline void os_entropy(std::uint32_t* words, std::size_t count) noexcept {
+            #if defined(RANDOMIZE_GETRANDOM)
+                const auto bytes = count * sizeof(std::uint32_t);
+                long result;
+                do {
+                    result = syscall(SYS_getrandom, words, bytes, 0);
+                } while (result < 0 && errno == EINTR);
+                if (result == static_cast<long>(bytes)) {
+                    return;
+                }
+            #endif
+            try {
+                std::random_device device;
+                for (std::size_t i = 0; i < count; ++i) {
+                    words[i] = static_cast<std::uint32_t>(device());
+                }
+            } catch (...) {
+                const auto time = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                for (std::size_t i = 0; i < count; ++i) {
+                    words[i] = static_cast<std::uint32_t>(mix64(time + 0x9e3779b97f4a7c15ULL * (i + 1)) >> 32);
+                }
+            }
+        }
+        
+        /**
+         * 256 bits key from which all the engines are seeded.
+         */
+        struct seed_key {
+            std::uint32_t words[8];
+        };
+        
+        /**
+         * Expand a 64 bits seed into a key with splitmix64.
+         * @return - the key.
+         */
+        inline seed_key expand_seed(std::uint64_t seed) noexcept {
+            seed_key key;
+            for (std::size_t i = 0; i < 4; ++i) {
+                const auto word = mix64(seed + 0x9e3779b97f4a7c15ULL * (i + 1));
+                key.words[2 * i] = static_cast<std::uint32_t>(word);
+                key.words[2 * i + 1] = static_cast<std::uint32_t>(word >> 32);
+            }
+            return key;
+        }
+        
+        /**
+         * Parse a seed: either a key of 64 hexadecimal digits, as logged,
+         * or a 64 bits integer, decimal or prefixed by 0x.
+         * @return - whether the text is a valid seed.
+         */
+        inline bool parse_seed(const char* text, seed_key& key) noexcept {
+            auto digit = [](char c) {
+                return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+            };
+            if (std::strlen(text) == 64 && std::all_of(text, text + 64, [digit](char c) { return digit(c) >= 0; })) {
+                for (std::size_t i = 0; i < 64; ++i) {
+                    auto& word = key.words[i / 8];
+                    word = (i % 8 == 0 ? 0 : word << 4) | static_cast<std::uint32_t>(digit(text[i]));
+                }
+                return true;
+            }
+            char* end;
+            errno = 0;
+            const auto seed = std::strtoull(text, &end, 0);
+            if (end == text || *end != '\0' || errno == ERANGE) {
+                return false;
+            }
+            key = expand_seed(seed);
+            return true;
+        }
+        
+        /**
+         * Whether the key is logged: only on request, as it is the root
+         * of every stream, including the ChaCha ones, and of the keys
+         * of the forked children and of the seed trees.
+         * @return - true when RANDOMIZE_SEED_LOG is defined, or set in
+         * the environment to anything but "" or "0".
+         */
+        inline bool seed_log_enabled() noexcept {
+            #if defined(RANDOMIZE_SEED_LOG)
+                return true;
+            #else
+                const auto text = std::getenv("RANDOMIZE_SEED_LOG");
+                return text != nullptr && *text != '\0' && std::strcmp(text, "0") != 0;
+            #endif
+        }
+        
+        /**
+         * The key of the process, taken from the RANDOMIZE_SEED
+         * environment variable when it is set, otherwise from the
+         * operating system. When seed_log_enabled(), it is written once
+         * to the standard error, as RANDOMIZE_SEED=<key>, so that the run
+         * can be replayed.
+         * @return - the key.
+         */
+        inline seed_key initial_key() noexcept {
+            seed_key key;
+            const auto text = std::getenv("RANDOMIZE_SEED");
+            const auto parsed = text != nullptr && parse_seed(text, key);
+            if (!parsed) {
+                os_entropy(key.words, 8);
+            }
+            if (text != nullptr && !parsed) {
+                std::fprintf(stderr, "randomize: invalid RANDOMIZE_SEED ignored\n");
+            }
+            if (seed_log_enabled()) {
+                char hex[65];
+                for (std::size_t i = 0; i < 8; ++i) {
+                    std::snprintf(hex + 8 * i, 9, "%08x", static_cast<unsigned>(key.words[i]));
+                }
+                std::fprintf(stderr, "randomize: RANDOMIZE_SEED=%s\n", hex);
+            }
+            return key;
+        }
+        
+        inline std::mutex& seed_mutex() noexcept {
+            static std::mutex mutex;
+            return mutex;
+        }
+        
+        /**
+         * Number of times the key was changed: the engines created from
+         * an older key reseed themselves on their next use.
+         */
+        inline std::atomic<unsigned>& seed_generation() noexcept {
+            static std::atomic<unsigned> generation{0};
+            return generation;
+        }
+        
+        inline std::atomic<std::uint64_t>& stream_counter() noexcept {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter;
+        }
+        
+        /**
+         * The key, which must be accessed with seed_mutex held. Once it
+         * exists, a child process replaces it on fork with a key derived
+         * with ChaCha8 from the key of the parent and the number of forks,
+         * so that the static and thread-local engines inherited from the
+         * parent are reseeded on their next draw, as with seed(), and the
+         * children of a replayed run are replayed too.
+         */
+        inline seed_key& seed_key_storage() noexcept {
+            static seed_key key = initial_key();
+            #if defined(RANDOMIZE_ATFORK)
+                static std::uint64_t forks = 0;
+                static const int hooked = pthread_atfork(
+                    [] {
+                        seed_mutex().lock();
+                        ++forks;
+                    },
+                    [] {
+                        seed_mutex().unlock();
+                    },
+                    [] {
+                        std::uint64_t block[8];
+                        chacha_blocks_generic<8, 1>(key.words, 0, ~forks, block);
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            key.words[2 * i] = static_cast<std::uint32_t>(block[i]);
+                            key.words[2 * i + 1] = static_cast<std::uint32_t>(block[i] >> 32);
+                        }
+                        stream_counter().store(0, std::memory_order_relaxed);
+                        seed_generation().fetch_add(1, std::memory_order_relaxed);
+                        seed_mutex().unlock();
+                    });
+                (void)hooked;
+            #endif
+            return key;
+        }
+        
+        /**
+         * The operating system is only queried once per process, for
+         * this key.
+         * @return - the key from which all the engines are seeded.
+         */
+        inline seed_key root_key() noexcept {
+            std::lock_guard<std::mutex> lock(seed_mutex());
+            return seed_key_storage();
+        }
+        
+        /**
+         * Replace the key, and start the streams over, so that the
+         * engines created from now on only depend on the key.
+         */
+        inline void reseed(const seed_key& key) noexcept {
+            std::lock_guard<std::mutex> lock(seed_mutex());
+            seed_key_storage() = key;
+            stream_counter().store(0, std::memory_order_relaxed);
+            seed_generation().fetch_add(1, std::memory_order_release);
+        }
+        
+        /**
+         * @return - the seed from which the engines which do not take
+         * a seed sequence are seeded.
+         */
+        inline std::uint64_t base_seed() noexcept {
+            const auto key = root_key();
+            return key.words[0] | (static_cast<std::uint64_t>(key.words[1]) << 32);
+        }
+        
+        /**
+         * @return - the index of a new stream, unique for the key.
+         */
+        inline std::uint64_t next_stream() noexcept {
+            return stream_counter().fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        /**
+         * Generate a seed for a new engine: each call derives a distinct
+         * seed from the base seed, so that engines created together, e.g.
+         * by threads started together, never share their streams.
+         * @return - a seed to feed to a random number generator.
+         */
+        inline std::uint64_t next_seed() noexcept {
+            return mix64(base_seed() + 0x9e3779b97f4a7c15ULL * (next_stream() + 1));
+        }
+        
+        /**
+         * SeedSequence which expands a key and a stream index with
+         * ChaCha8 into as many words as asked, so that engines with a
+         * large state, e.g. std::mt19937_64, get all of it seeded. The
+         * sequences of different streams are independent.
+         */
+        class seed_sequence {
+        public:
+            using result_type = std::uint32_t;
+            
+            seed_sequence(const seed_key& key, std::uint64_t stream) noexcept : key_(key), stream_{stream} {}
+            
+            template <typename Iterator>
+            void generate(Iterator first, Iterator last) {
+                engines::chacha8 expander{key_.words, stream_};
+                while (first != last) {
+                    const auto word = expander();
+                    *first++ = static_cast<result_type>(word);
+                    if (first != last) {
+                        *first++ = static_cast<result_type>(word >> 32);
+                    }
+                }
+            }
+            
+            std::size_t size() const noexcept {
+                return 10;
+            }
+            
+            template <typename OutputIterator>
+            void param(OutputIterator dest) const {
+                dest = std::copy(std::begin(key_.words), std::end(key_.words), dest);
+                *dest++ = static_cast<result_type>(stream_);
+                *dest++ = static_cast<result_type>(stream_ >> 32);
+            }
+            
+        private:
+            seed_key key_;
+            std::uint64_t stream_;
+        };
+        
+        /**
+         * Derive the seed of an independent stream from a seed and
+         * a stream index.
+         * @return - a seed to feed to a random number generator.
+         */
+        constexpr std::uint64_t stream_seed(std::uint64_t seed, std::uint64_t stream) noexcept {
+            return mix64(seed ^ mix64(stream + 0x9e3779b97f4a7c15ULL));
+        }
+        
+        /**
+         * Whether an engine provides jump(times), which advances it by
+         * times non-overlapping streams, like the xoshiro engines.
+         */
+        template <typename Engine, typename TEnable = void>
+        struct has_jump : std::false_type {};
+        
+        template <typename Engine>
+        struct has_jump<Engine, decltype(std::declval<Engine&>().jump(std::declval<unsigned long long>()), void())> : std::true_type {};
+        
+        /**
+         * Whether an engine provides discard_fast(n).
+         */
+        template <typename Engine, typename TEnable = void>
+        struct has_discard_fast : std::false_type {};
+        
+        template <typename Engine>
+        struct has_discard_fast<Engine, decltype(std::declval<Engine&>().discard_fast(std::declval<unsigned long long>()), void())> : std::true_type {};
+        
+        template <typename Engine>
+        void discard_fast(Engine& engine, unsigned long long n, std::true_type) {
+            engine.discard_fast(n);
+        }
+        
+        template <typename Engine>
+        void discard_fast(Engine& engine, unsigned long long n, std::false_type) {
+            engine.discard(n);
+        }
+        
+        /**
+         * Skip n outputs of std::mt19937_64 in O(log n). Its state is only
+         * accessible through its textual representation, whose words are
+         * jumped over whole state regenerations with the minimal polynomial
+         * of the recursion. As for SFMT, this only pays off for jumps of
+         * more than a few million outputs.
+         */
+        inline void discard_fast(std::mt19937_64& engine, unsigned long long n, std::false_type) {
+            constexpr auto size = std::mt19937_64::state_size;
+            if (n / size <= 256 * size) {
+                engine.discard(n);
+                return;
+            }
+            std::stringstream text;
+            text << engine;
+            mt19937_64_state state;
+            for (auto& word : state) {
+                text >> word;
+            }
+            
+            std::size_t index;
+            if (text >> index) {
+                // libstdc++ writes the state as the current block of words,
+                // followed by the index of the next one, in (0, size] after
+                // discard: it is kept the same so that operator== holds
+                const auto position = index + n % size;
+                auto regenerations = n / size;
+                if (position > size) {
+                    ++regenerations;
+                } else if (position == 0) {
+                    --regenerations;
+                }
+                gf2_jump(state, gf2_x_power_mod(regenerations, mt19937_64_minimal_polynomial()), mt19937_64_generate);
+                std::stringstream jumped;
+                for (const auto word : state) {
+                    jumped << word << ' ';
+                }
+                jumped << (position + size - 1) % size + 1;
+                jumped >> engine;
+                return;
+            }
+            
+            // The state is the last size words generated
+            gf2_jump(state, gf2_x_power_mod(n / size, mt19937_64_minimal_polynomial()), mt19937_64_generate);
+            std::stringstream jumped;
+            for (const auto word : state) {
+                jumped << word << ' ';
+            }
+            jumped >> engine;
+            engine.discard(n % size);
+        }
+        
+        template <typename Engine>
+        Engine make_stream_engine(std::uint64_t seed, std::uint64_t stream, std::true_type) {
+            return Engine(static_cast<typename Engine::result_type>(seed), stream);
+        }
+        
+        template <typename Engine>
+        Engine make_stream_engine(std::uint64_t seed, std::uint64_t stream, std::false_type) {
+            return Engine(static_cast<typename Engine::result_type>(stream_seed(seed, stream)));
+        }
+        
+        /**
+         * Create the engine of an independent stream: counter-based engines
+         * take the stream as part of their key, the others are seeded with
+         * a seed derived from the stream.
+         * @return - the engine.
+         */
+        template <typename Engine>
+        Engine make_stream_engine(std::uint64_t seed, std::uint64_t stream) {
+            return make_stream_engine<Engine>(seed, stream, std::is_constructible<Engine, typename Engine::result_type, std::uint64_t>{});
+        }
+        
+        template <typename Engine>
+        Engine make_engine(std::true_type, std::true_type) {
+            static Engine next;
+            static unsigned generation = 0;
+            static bool seeded = false;
+            // The key lock also guards the fork of the process
+            std::lock_guard<std::mutex> lock(seed_mutex());
+            const auto current = seed_generation().load(std::memory_order_acquire);
+            if (!seeded || generation != current) {
+                seed_sequence seq{seed_key_storage(), 0};
+                next.seed(seq);
+                generation = current;
+                seeded = true;
+            }
+            auto engine = next;
+            next.jump(1);
+            return engine;
+        }
+        
+        template <typename Engine>
+        Engine make_engine(std::false_type, std::true_type) {
+            seed_sequence seq{root_key(), next_stream() + 1};
+            return Engine(seq);
+        }
+        
+        template <typename Engine>
+        Engine make_engine(std::true_type, std::false_type) {
+            auto engine = Engine(static_cast<typename Engine::result_type>(base_seed()));
+            engine.jump(next_stream());
+            return engine;
+        }
+        
+        template <typename Engine>
+        Engine make_engine(std::false_type, std::false_type) {
+            return Engine(static_cast<typename Engine::result_type>(next_seed()));
+        }
+        
+        /**
+         * Create a freshly seeded engine. Its whole state is seeded from
+         * the root key when it takes a seed sequence, as the standard
+         * engines do. The engines which can jump ahead are then copies of
+         * a single one, jumped once after each copy, so that e.g. the
+         * engines of different threads never overlap; the others get the
+         * sequence of their own stream.
+         * @return - the engine.
+         */
+        template <typename Engine>
+        Engine make_engine() {
+            return make_engine<Engine>(has_jump<Engine>{}, std::is_constructible<Engine, seed_sequence&>{});
+        }
+        
+        /**
+         * An engine, with the generation of the key it was seeded from.
+         */
+        template <typename Engine>
+        struct seeded_engine {
+            /**
+             * Seeding is kept out of line, so that the check of the
+             * generation is all that remains on the path of each draw.
+             */
+            RANDOMIZE_NOINLINE seeded_engine() : generation{seed_generation().load(std::memory_order_relaxed)}, engine(make_engine<Engine>()) {}
+            
+            RANDOMIZE_NOINLINE void reseed(unsigned current) {
+                generation = current;
+                engine = make_engine<Engine>();
+            }
+            
+            unsigned generation;
+            Engine engine;
+        };
+        
+        /**
+         * The engine shared by rand, get_rand and every rand<T, min, max>
+         * instantiation: there is a single one per engine type (per thread
+         * with RANDOMIZE_THREAD_LOCAL_ENGINES), whatever the number of
+         * ranges in use. It is always accessed through this function so
+         * that a function returned by get_rand in one thread and called in
+         * another one uses the engine of the calling thread, and so that
+         * it is reseeded when the global seed changes.
+         * @return - the engine.
+         */
+        template <typename Engine>
+        Engine& shared_engine() {
+            RANDOMIZE_ENGINE_STORAGE seeded_engine<Engine> seeded;
+            const auto current = seed_generation().load(std::memory_order_relaxed);
+            if (RANDOMIZE_UNLIKELY(seeded.generation != current)) {
+                seeded.reseed(current);
+            }
+            return seeded.engine;
+        }
+        
+        /**
+         * Number of random bits produced by each call to an engine,
+         * or 0 when its range is not a power of two.
+         */
+        template <typename Engine>
+        struct engine_bits {
+            static constexpr std::uint64_t span = static_cast<std::uint64_t>(Engine::max() - Engine::min());
+            static constexpr int value =
+                Engine::min() != 0 ? 0 :
+                span == std::numeric_limits<std::uint64_t>::max() ? 64 :
+                span == std::numeric_limits<std::uint32_t>::max() ? 32 : 0;
+        };
+        
+        template <typename Engine>
+        std::uint64_t bits64(Engine& engine, std::integral_constant<int, 64>) {
+            return static_cast<std::uint64_t>(engine());
+        }
+        
+        template <typename Engine>
+        std::uint64_t bits64(Engine& engine, std::integral_constant<int, 32>) {
+            const auto hi = static_cast<std::uint64_t>(engine());
+            return (hi << 32) | static_cast<std::uint64_t>(engine());
+        }
+        
+        /**
+         * Fallback for engines with an odd range, such as std::minstd_rand.
+         * The output then depends on the standard library.
+         */
+        template <typename Engine>
+        std::uint64_t bits64(Engine& engine, std::integral_constant<int, 0>) {
+            return std::uniform_int_distribution<std::uint64_t>{}(engine);
+        }
+        
+        /**
+         * 64 uniformly distributed random bits.
+         * @return - the bits drawn from the engine.
+         */
+        template <typename Engine>
+        std::uint64_t bits64(Engine& engine) {
+            return bits64(engine, std::integral_constant<int, engine_bits<Engine>::value>{});
+        }
+        
+        /**
+         * 32 uniformly distributed random bits. Only the high bits of
+         * a 64 bits engine are kept, as they are the strongest ones for
+         * some generators.
+         * @return - the bits drawn from the engine.
+         */
+        template <typename Engine>
+        std::uint32_t bits32(Engine& engine) {
+            return engine_bits<Engine>::value == 32
+                ? static_cast<std::uint32_t>(engine())
+                : static_cast<std::uint32_t>(bits64(engine) >> 32);
+        }
+        
+        /**
+         * Uniform bits of a given width.
+         */
+        template <typename Word>
+        struct bits;
+        
+        template <>
+        struct bits<std::uint32_t> {
+            template <typename Engine>
+            static std::uint32_t draw(Engine& engine) { return bits32(engine); }
+        };
+        
+        template <>
+        struct bits<std::uint64_t> {
+            template <typename Engine>
+            static std::uint64_t draw(Engine& engine) { return bits64(engine); }
+        };
+        
+        /**
+         * Number of 64 bits words generated at once by the bulk
+         * functions: 2 KB, so that a block stays in the L1 cache.
+         */
+        constexpr std::size_t block_size = 256;
+        
+        /**
+         * Whether an engine provides generate_block(first, count), which
+         * must write its next count outputs, as a faster batched path.
+         */
+        template <typename Engine, typename TEnable = void>
+        struct has_generate_block : std::false_type {};
+        
+        template <typename Engine>
+        struct has_generate_block<Engine, decltype(std::declval<Engine&>().generate_block(
+            std::declval<std::uint64_t*>(), std::size_t{}), void())> : std::integral_constant<bool, engine_bits<Engine>::value == 64> {};
+        
+        template <typename Engine>
+        void generate_block(Engine& engine, std::uint64_t* first, std::size_t count, std::false_type) {
+            for (std::size_t i = 0; i < count; ++i) {
+                first[i] = bits64(engine);
+            }
+        }
+        
+        template <typename Engine>
+        void generate_block(Engine& engine, std::uint64_t* first, std::size_t count, std::true_type) {
+            engine.generate_block(first, count);
+        }
+        
+        /**
+         * Whether an engine gives out doubles in [1, 2) natively, through
+         * close1_open2() and fill_close1_open2(first, count), like dSFMT.
+         */
+        template <typename Engine, typename TEnable = void>
+        struct has_close1_open2 : std::false_type {};
+        
+        template <typename Engine>
+        struct has_close1_open2<Engine, decltype(std::declval<Engine&>().close1_open2(),
+            std::declval<Engine&>().fill_close1_open2(std::declval<double*>(), std::size_t{}), void())> : std::true_type {};
+        
+        /**
+         * Generate a block of 64 bits words from an engine.
+         */
+        template <typename Engine>
+        void generate_block(Engine& engine, std::uint64_t* first, std::size_t count) {
+            generate_block(engine, first, count, has_generate_block<Engine>{});
+        }
+        
+        /**
+         * Number of words of a given width in a block.
+         */
+        template <typename Word>
+        struct block_words {
+            static constexpr std::size_t value = block_size * sizeof(std::uint64_t) / sizeof(Word);
+        };
+        
+        /**
+         * Generate up to a block of words of a given width: 32 bits words
+         * are the high then the low halves of 64 bits words, in the same
+         * order as the one used by bits32 and uniform_real_distribution.
+         * @return - the number of words generated.
+         */
+        template <typename Engine>
+        std::size_t generate_words(Engine& engine, std::uint64_t* first, std::size_t count) {
+            const auto words = count < block_size ? count : block_size;
+            generate_block(engine, first, words);
+            return words;
+        }
+        
+        template <typename Engine>
+        std::size_t generate_words(Engine& engine, std::uint32_t* first, std::size_t count) {
+            std::uint64_t block[block_size];
+            const auto words = count < 2 * block_size ? count : 2 * block_size;
+            generate_block(engine, block, (words + 1) / 2);
+            for (std::size_t i = 0; i < words / 2; ++i) {
+                first[2 * i] = static_cast<std::uint32_t>(block[i] >> 32);
+                first[2 * i + 1] = static_cast<std::uint32_t>(block[i]);
+            }
+            if (words % 2 != 0) {
+                first[words - 1] = static_cast<std::uint32_t>(block[words / 2] >> 32);
+            }
+            return words;
+        }
+        
+        /**
+         * Fill [first, last) by blocks: words are generated from the
+         * engine, then converted by convert(words, values, count). Full
+         * blocks are converted into a local buffer, as a loop with a
+         * constant trip count and no aliasing is vectorized even at -O2.
+         */
+        template <typename T, typename Word, typename Engine, typename Convert>
+        void fill_blocks(Engine& engine, T* first, T* last, Convert convert) {
+            constexpr auto size = block_words<Word>::value;
+            Word words[size];
+            T values[size];
+            while (first != last) {
+                const auto count = generate_words(engine, words, static_cast<std::size_t>(last - first));
+                if (count == size) {
+                    convert(words, values, size);
+                    first = std::copy(values, values + size, first);
+                } else {
+                    convert(words, first, count);
+                    first += count;
+                }
+            }
+        }
+        
+        /**
+         * Full multiplication of two words.
+         * @return - the low half of the product, the high half
+         * is stored in hi.
+         */
+        inline std::uint32_t mul_wide(std::uint32_t a, std::uint32_t b, std::uint32_t& hi) noexcept {
+            const auto product = static_cast<std::uint64_t>(a) * b;
+            hi = static_cast<std::uint32_t>(product >> 32);
+            return static_cast<std::uint32_t>(product);
+        }
+        
+        inline std::uint64_t mul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept {
+            return umul128(a, b, hi);
+        }
+        
+        /**
+         * Word used to reduce the range of an integral type: 32 bits
+         * whenever they are enough, as they are cheaper to multiply.
+         */
+        template <typename T>
+        using range_word = std::conditional_t<(sizeof(T) <= sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+        
+        /**
+         * Runtime dispatched conversion of a full block of words into
+         * values of type T, when there is one for T: see the
+         * specializations after the kernels below.
+         */
+        template <typename T, typename TEnable = void>
+        struct bulk_kernel {
+            static constexpr bool available = false;
+            
+            template <typename... Args>
+            static bool apply(Args&&...) noexcept { return false; }
+        };
+        
+        /**
+         * Bounded integers with Lemire's nearly divisionless method
+         * ("Fast Random Integer Generation in an Interval", 2019): the
+         * range is reduced by a multiplication and a shift, and the
+         * division needed to reject the biased values is only done in
+         * the rare case where the result could be biased.
+         * Unlike std::uniform_int_distribution, the output only depends
+         * on the engine output, so it is the same with every standard
+         * library.
+         */
+        template <typename T>
+        class uniform_int_distribution {
+        public:
+            using result_type = T;
+            using word_type = range_word<T>;
+            
+            uniform_int_distribution(T min, T max) noexcept
+                : min_{min},
+                  max_{max},
+                  range_{static_cast<word_type>(static_cast<word_type>(max) - static_cast<word_type>(min) + 1)} {}
+            
+            result_type min() const noexcept { return min_; }
+            result_type max() const noexcept { return max_; }
+            
+            /**
+             * Generate a random number.
+             * @return - random number in the range [min, max].
+             */
+            template <typename Engine>
+            result_type operator()(Engine& engine) const {
+                auto x = bits<word_type>::draw(engine);
+                if (range_ == 0) {
+                    // The range spans every value of the word
+                    return static_cast<T>(x);
+                }
+                
+                word_type hi;
+                auto lo = mul_wide(x, range_, hi);
+                if (lo < range_) {
+                    const auto threshold = static_cast<word_type>(-range_) % range_;
+                    while (lo < threshold) {
+                        x = bits<word_type>::draw(engine);
+                        lo = mul_wide(x, range_, hi);
+                    }
+                }
+                
+                return static_cast<T>(static_cast<word_type>(min_) + hi);
+            }
+            
+            /**
+             * Fill [first, last) with random numbers. The engine output is
+             * generated by blocks, and reduced by a branchless loop which
+             * only records whether a value must be rejected. Rejected values,
+             * which are rare, are then drawn again one by one.
+             */
+            template <typename Engine>
+            void fill(Engine& engine, T* first, T* last) const {
+                if (range_ == 0) {
+                    fill_blocks<T, word_type>(engine, first, last, [](const word_type* words, T* values, std::size_t count) {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            values[i] = static_cast<T>(words[i]);
+                        }
+                    });
+                    return;
+                }
+                
+                const auto range = range_;
+                const auto threshold = static_cast<word_type>(static_cast<word_type>(-range) % range);
+                const auto offset = static_cast<word_type>(min_);
+                fill_blocks<T, word_type>(engine, first, last, [&](const word_type* words, T* values, std::size_t count) {
+                    bool rejected = false;
+                    if (bulk_kernel<T>::available && count == block_words<word_type>::value) {
+                        rejected = bulk_kernel<T>::apply(words, values, range, threshold, offset);
+                    } else {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            word_type hi;
+                            const auto lo = mul_wide(words[i], range, hi);
+                            values[i] = static_cast<T>(offset + hi);
+                            rejected |= lo < threshold;
+                        }
+                    }
+                    if (rejected) {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            word_type hi;
+                            if (mul_wide(words[i], range, hi) < threshold) {
+                                values[i] = (*this)(engine);
+                            }
+                        }
+                    }
+                });
+            }
+            
+        private:
+            T min_;
+            T max_;
+            word_type range_;
+        };
+        
+        /**
+         * Bounded integers with min and max known at compile time: the
+         * same algorithm, and output, as uniform_int_distribution but the
+         * range width and the rejection threshold are constants. Hence,
+         * the reduction compiles to a multiply-shift (a plain shift for
+         * power of two widths) and the rejection test disappears when the
+         * width is a power of two.
+         */
+        template <typename T, T min_value, T max_value>
+        class static_uniform_int_distribution {
+        public:
+            using result_type = T;
+            using word_type = range_word<T>;
+            
+            static constexpr word_type range =
+                static_cast<word_type>(static_cast<word_type>(max_value) - static_cast<word_type>(min_value) + 1);
+            
+            static constexpr bool is_power_of_two = (range & (range - 1)) == 0;
+            
+            static constexpr word_type threshold =
+                is_power_of_two ? 0 : static_cast<word_type>(static_cast<word_type>(-range) % range);
+            
+            static constexpr result_type min() noexcept { return min_value; }
+            static constexpr result_type max() noexcept { return max_value; }
+            
+            /**
+             * Generate a random number.
+             * @return - random number in the range [min, max].
+             */
+            template <typename Engine>
+            result_type operator()(Engine& engine) const {
+                auto x = bits<word_type>::draw(engine);
+                if (range == 0) {
+                    // The range spans every value of the word
+                    return static_cast<T>(x);
+                }
+                
+                word_type hi;
+                auto lo = mul_wide(x, range, hi);
+                while (lo < threshold) {
+                    x = bits<word_type>::draw(engine);
+                    lo = mul_wide(x, range, hi);
+                }
+                
+                return static_cast<T>(static_cast<word_type>(min_value) + hi);
+            }
+        };
+        
+        /**
+         * Layout of the draws of a range packed into a 64 bits word: a
+         * word reduced to [0, product) by Lemire's method gives count
+         * independent draws, its digits in base range ("Batched Ranged
+         * Random Integer Generation", Brackett-Rozinsky and Lemire, 2024).
+         * product is range^count, 0 standing for 2^64, and the words whose
+         * product with it modulo 2^64 is below threshold are rejected.
+         * There are e.g. 64 draws per word for a coin flip, 23 for a dice
+         * and 8 for a byte.
+         */
+        struct pool_layout {
+            std::uint64_t product;
+            std::uint64_t threshold;
+            unsigned count;
+        };
+        
+        /**
+         * The largest power of the range which fits in a word is not
+         * always the best one, as more words may be rejected: 34% of them
+         * for 40 draws of [0, 3), but 5% for 38 draws. Since more than half
+         * of the words are accepted whatever the power, the count with the
+         * most accepted draws per word is above half the largest one.
+         * @return - the layout of a range, which is neither 0 (2^64)
+         * nor 1, which need no pooling.
+         */
+        constexpr pool_layout make_pool_layout(std::uint64_t range) noexcept {
+            const auto limit = std::numeric_limits<std::uint64_t>::max() / range;
+            std::uint64_t product = 1;
+            unsigned count = 0;
+            while (product <= limit) {
+                product *= range;
+                ++count;
+            }
+            if (product - 1 == limit && static_cast<std::uint64_t>(product * range) == 0) {
+                // A power of two whose bits divide 64, range^count being 2^64
+                return pool_layout{0, 0, count + 1};
+            }
+            
+            pool_layout best{product, 0, 0};
+            std::uint64_t best_draws = 0;
+            for (; 2 * count > best.count; --count, product /= range) {
+                const auto threshold = static_cast<std::uint64_t>(0 - product) % product;
+                // Accepted draws per word, in units of 2^-56
+                const auto accepted = threshold == 0 ? std::uint64_t{1} << 56 : static_cast<std::uint64_t>(0 - threshold) >> 8;
+                if (count * accepted > best_draws) {
+                    best = pool_layout{product, threshold, count};
+                    best_draws = count * accepted;
+                }
+            }
+            return best;
+        }
+        
+        /**
+         * The draws left in the last word of a pooled distribution.
+         * A copy starts empty, so that two copies never give out the
+         * same draws, and the draws taken before the global seed last
+         * changed, e.g. in the parent of a forked process, are dropped,
+         * so that seed() replays the pooled draws too.
+         */
+        class draw_pool {
+        public:
+            draw_pool() = default;
+            
+            draw_pool(const draw_pool&) noexcept {}
+            
+            draw_pool& operator=(const draw_pool&) noexcept {
+                left_ = 0;
+                return *this;
+            }
+            
+            /**
+             * The engine is only reached, through source(), when the
+             * pool is empty.
+             * @return - the next draw in [0, range).
+             */
+            template <typename EngineSource>
+            std::uint64_t next(EngineSource& source, std::uint64_t range, std::uint64_t product,
+                               std::uint64_t threshold, unsigned count) {
+                const auto current = seed_generation().load(std::memory_order_relaxed);
+                if (RANDOMIZE_UNLIKELY(left_ == 0 || generation_ != current)) {
+                    refill(source(), product, threshold, count, current);
+                }
+                --left_;
+                std::uint64_t hi;
+                word_ = mul_wide(word_, range, hi);
+                return hi;
+            }
+            
+        private:
+            template <typename Engine>
+            RANDOMIZE_NOINLINE void refill(Engine& engine, std::uint64_t product, std::uint64_t threshold,
+                                           unsigned count, unsigned generation) {
+                do {
+                    word_ = bits64(engine);
+                } while (static_cast<std::uint64_t>(word_ * product) < threshold);
+                left_ = count;
+                generation_ = generation;
+            }
+            
+            std::uint64_t word_ = 0;
+            unsigned left_ = 0;
+            unsigned generation_ = 0;
+        };
+        
+        /**
+         * Width of an integral range as a 64 bits word, 0 standing
+         * for 2^64.
+         * @return - the number of values in [min, max].
+         */
+        template <typename T>
+        constexpr std::uint64_t range_width(T min, T max) noexcept {
+            return static_cast<std::uint64_t>(static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min) + 1);
+        }
+        
+        /**
+         * Bounded integers drawn several at a time from each word of the
+         * engine, see pool_layout. Each draw is unbiased, and independent
+         * from the others, but the output differs from the one of
+         * uniform_int_distribution, which takes a word per draw.
+         */
+        template <typename T>
+        class pooled_int_distribution {
+        public:
+            using result_type = T;
+            
+            pooled_int_distribution(T min, T max) noexcept
+                : min_{min},
+                  max_{max},
+                  range_{range_width(min, max)},
+                  layout_(range_ > 1 ? make_pool_layout(range_) : pool_layout{0, 0, 1}) {}
+            
+            result_type min() const noexcept { return min_; }
+            result_type max() const noexcept { return max_; }
+            
+            /**
+             * Generate a random number.
+             * @return - random number in the range [min, max].
+             */
+            template <typename Engine>
+            result_type operator()(Engine& engine) {
+                return draw([&engine]() -> Engine& { return engine; });
+            }
+            
+            /**
+             * Generate a random number from the engine returned by
+             * source(), which is only called when the pool is empty.
+             * @return - random number in the range [min, max].
+             */
+            template <typename EngineSource>
+            result_type draw(EngineSource&& source) {
+                if (range_ <= 1) {
+                    return range_ == 0 ? static_cast<T>(bits64(source())) : min_;
+                }
+                const auto value = pool_.next(source, range_, layout_.product, layout_.threshold, layout_.count);
+                return static_cast<T>(static_cast<std::uint64_t>(min_) + value);
+            }
+            
+        private:
+            T min_;
+            T max_;
+            std::uint64_t range_;
+            pool_layout layout_;
+            draw_pool pool_;
+        };
+        
+        /**
+         * Pooled bounded integers with min and max known at compile
+         * time: the layout is computed by the compiler, so that a draw
+         * is a multiplication by a constant.
+         */
+        template <typename T, T min_value, T max_value>
+        class static_pooled_int_distribution {
+        public:
+            using result_type = T;
+            
+            static constexpr std::uint64_t range = range_width(min_value, max_value);
+            static constexpr bool pooled = range > 1;
+            static constexpr std::uint64_t product = pooled ? make_pool_layout(range).product : 0;
+            static constexpr std::uint64_t threshold = pooled ? make_pool_layout(range).threshold : 0;
+            static constexpr unsigned count = pooled ? make_pool_layout(range).count : 1;
+            
+            static constexpr result_type min() noexcept { return min_value; }
+            static constexpr result_type max() noexcept { return max_value; }
+            
+            /**
+             * Generate a random number.
+             * @return - random number in the range [min, max].
+             */
+            template <typename Engine>
+            result_type operator()(Engine& engine) {
+                return draw([&engine]() -> Engine& { return engine; });
+            }
+            
+            /**
+             * Generate a random number from the engine returned by
+             * source(), which is only called when the pool is empty.
+             * @return - random number in the range [min, max].
+             */
+            template <typename EngineSource>
+            result_type draw(EngineSource&& source) {
+                if (!pooled) {
+                    return range == 0 ? static_cast<T>(bits64(source())) : min_value;
+                }
+                const auto value = pool_.next(source, range, product, threshold, count);
+                return static_cast<T>(static_cast<std::uint64_t>(min_value) + value);
+            }
+            
+        private:
+            draw_pool pool_;
+        };
+        
+        /**
+         * a * b + c, with a single rounding when the hardware supports it.
+         * @return - the result of the multiply-add.
+         */
+        inline float multiply_add(float a, float b, float c) noexcept {
+            #if defined(FP_FAST_FMAF)
+                return std::fma(a, b, c);
+            #else
+                return a * b + c;
+            #endif
+        }
+        
+        inline double multiply_add(double a, double b, double c) noexcept {
+            #if defined(FP_FAST_FMA)
+                return std::fma(a, b, c);
+            #else
+                return a * b + c;
+            #endif
+        }
+        
+        inline long double multiply_add(long double a, long double b, long double c) noexcept {
+            #if defined(FP_FAST_FMAL)
+                return std::fma(a, b, c);
+            #else
+                return a * b + c;
+            #endif
+        }
+        
+        /**
+         * The rounding of u * (max - min) + min gives max itself for some
+         * u close to 1, so the results are clamped to the largest value
+         * below max. It compiles to a min instruction, which vectorizes.
+         * @return - value, or limit when value is not below it.
+         */
+        template <typename T>
+        RANDOMIZE_ALWAYS_INLINE T clamp_below(T value, T limit) noexcept {
+            return value < limit ? value : limit;
+        }
+        
+        /**
+         * Conversion of random bits to a floating point number in [0, 1):
+         * the bits fill the mantissa, 24 bits for a float and 53 bits for
+         * a double, and are scaled by a power of two.
+         */
+        template <typename T>
+        struct canonical {
+            static constexpr int digits = std::numeric_limits<T>::digits < 64 ? std::numeric_limits<T>::digits : 64;
+            
+            using word_type = std::conditional_t<(digits <= 32), std::uint32_t, std::uint64_t>;
+            
+            static constexpr int shift = static_cast<int>(sizeof(word_type)) * 8 - digits;
+            
+            static constexpr T scale = T(1) / (static_cast<T>(std::uint64_t{1} << (digits - 1)) * 2);
+            
+            // Converting from a signed integer is cheaper, and vectorizes
+            using integer_type = std::conditional_t<(shift > 0), std::make_signed_t<word_type>, word_type>;
+            
+            static T from_bits(word_type x) noexcept {
+                return static_cast<T>(static_cast<integer_type>(x >> shift)) * scale;
+            }
+        };
+        
+        /**
+         * Exact conversion of an integer below 2^53 to a double, through
+         * the exponent bits, so that it vectorizes even without the 64 bits
+         * integer conversions of AVX-512.
+         * @return - the converted value.
+         */
+        RANDOMIZE_ALWAYS_INLINE double to_double_53(std::uint64_t x) noexcept {
+            const std::uint64_t lo_bits = (x & 0xffffffffULL) | 0x4330000000000000ULL;  // 2^52 + lo
+            const std::uint64_t hi_bits = (x >> 32) | 0x4530000000000000ULL;           // 2^84 + hi * 2^32
+            double lo, hi;
+            std::memcpy(&lo, &lo_bits, sizeof lo);
+            std::memcpy(&hi, &hi_bits, sizeof hi);
+            return (hi - 19342813118337666422669312.0) + lo;  // 2^84 + 2^52
+        }
+        
+        /**
+         * Conversion kernels of a full block, written as plain loops. They
+         * are compiled for each instruction set by the wrappers below, and
+         * give the same results as the scalar conversions.
+         */
+        RANDOMIZE_ALWAYS_INLINE void float_kernel(const std::uint32_t* RANDOMIZE_RESTRICT words, float* RANDOMIZE_RESTRICT values,
+                                                  float scale, float offset, float limit) noexcept {
+            for (std::size_t i = 0; i < block_words<std::uint32_t>::value; ++i) {
+                values[i] = clamp_below(multiply_add(canonical<float>::from_bits(words[i]), scale, offset), limit);
+            }
+        }
+        
+        RANDOMIZE_ALWAYS_INLINE void double_kernel(const std::uint64_t* RANDOMIZE_RESTRICT words, double* RANDOMIZE_RESTRICT values,
+                                                   double scale, double offset, double limit) noexcept {
+            for (std::size_t i = 0; i < block_words<std::uint64_t>::value; ++i) {
+                const auto u = to_double_53(words[i] >> canonical<double>::shift) * canonical<double>::scale;
+                values[i] = clamp_below(multiply_add(u, scale, offset), limit);
+            }
+        }
+        
+        RANDOMIZE_ALWAYS_INLINE bool uint32_kernel(const std::uint32_t* RANDOMIZE_RESTRICT words, std::uint32_t* RANDOMIZE_RESTRICT values,
+                                                   std::uint32_t range, std::uint32_t threshold, std::uint32_t offset) noexcept {
+            std::uint32_t rejected = 0;
+            for (std::size_t i = 0; i < block_words<std::uint32_t>::value; ++i) {
+                const auto product = static_cast<std::uint64_t>(words[i]) * range;
+                values[i] = offset + static_cast<std::uint32_t>(product >> 32);
+                rejected |= static_cast<std::uint32_t>(product) < threshold ? 1u : 0u;
+            }
+            return rejected != 0;
+        }
+        
+        inline void float_generic(const std::uint32_t* words, float* values, float scale, float offset, float limit) noexcept {
+            float_kernel(words, values, scale, offset, limit);
+        }
+        
+        inline void double_generic(const std::uint64_t* words, double* values, double scale, double offset, double limit) noexcept {
+            double_kernel(words, values, scale, offset, limit);
+        }
+        
+        inline bool uint32_generic(const std::uint32_t* words, std::uint32_t* values,
+                                   std::uint32_t range, std::uint32_t threshold, std::uint32_t offset) noexcept {
+            return uint32_kernel(words, values, range, threshold, offset);
+        }
+        
+        #if defined(RANDOMIZE_X86_DISPATCH)
+            RANDOMIZE_TARGET("avx2")
+            inline void float_avx2(const std::uint32_t* words, float* values, float scale, float offset, float limit) noexcept {
+                float_kernel(words, values, scale, offset, limit);
+            }
+            
+            RANDOMIZE_TARGET("avx2")
+            inline void double_avx2(const std::uint64_t* words, double* values, double scale, double offset, double limit) noexcept {
+                double_kernel(words, values, scale, offset, limit);
+            }
+            
+            RANDOMIZE_TARGET("avx2")
+            inline bool uint32_avx2(const std::uint32_t* words, std::uint32_t* values,
+                                    std::uint32_t range, std::uint32_t threshold, std::uint32_t offset) noexcept {
+                return uint32_kernel(words, values, range, threshold, offset);
+            }
+            
+            RANDOMIZE_TARGET("avx512f,avx512dq")
+            inline void float_avx512(const std::uint32_t* words, float* values, float scale, float offset, float limit) noexcept {
+                float_kernel(words, values, scale, offset, limit);
+            }
+            
+            RANDOMIZE_TARGET("avx512f,avx512dq")
+            inline void double_avx512(const std::uint64_t* words, double* values, double scale, double offset, double limit) noexcept {
+                double_kernel(words, values, scale, offset, limit);
+            }
+            
+            RANDOMIZE_TARGET("avx512f,avx512dq")
+            inline bool uint32_avx512(const std::uint32_t* words, std::uint32_t* values,
+                                      std::uint32_t range, std::uint32_t threshold, std::uint32_t offset) noexcept {
+                return uint32_kernel(words, values, range, threshold, offset);
+            }
+        #endif
+        
+        /**
+         * The conversion kernels for the best instruction set of the CPU.
+         */
+        struct block_kernels {
+            void (*to_float)(const std::uint32_t*, float*, float, float, float);
+            void (*to_double)(const std::uint64_t*, double*, double, double, double);
+            bool (*to_uint32)(const std::uint32_t*, std::uint32_t*, std::uint32_t, std::uint32_t, std::uint32_t);
+        };
+        
+        inline const block_kernels& current_block_kernels() noexcept {
+            static const block_kernels kernels = [] {
+                switch (current_instruction_set()) {
+                    #if defined(RANDOMIZE_X86_DISPATCH)
+                        case instruction_set::avx512:
+                            return block_kernels{float_avx512, double_avx512, uint32_avx512};
+                        case instruction_set::avx2:
+                            return block_kernels{float_avx2, double_avx2, uint32_avx2};
+                    #endif
+                    default:
+                        return block_kernels{float_generic, double_generic, uint32_generic};
+                }
+            }();
+            return kernels;
+        }
+        
+        template <>
+        struct bulk_kernel<float> {
+            static constexpr bool available = true;
+            
+            static bool apply(const std::uint32_t* words, float* values, float scale, float offset, float limit) noexcept {
+                current_block_kernels().to_float(words, values, scale, offset, limit);
+                return false;
+            }
+        };
+        
+        template <>
+        struct bulk_kernel<double> {
+            static constexpr bool available = true;
+            
+            static bool apply(const std::uint64_t* words, double* values, double scale, double offset, double limit) noexcept {
+                current_block_kernels().to_double(words, values, scale, offset, limit);
+                return false;
+            }
+        };
+        
+        /**
+         * 32 bits integers, the only ones which may alias std::uint32_t.
+         * @return - whether a value must be rejected.
+         */
+        template <typename T>
+        struct bulk_kernel<T, std::enable_if_t<std::is_same<T, std::int32_t>::value || std::is_same<T, std::uint32_t>::value>> {
+            static constexpr bool available = true;
+            
+            static bool apply(const std::uint32_t* words, T* values,
+                              std::uint32_t range, std::uint32_t threshold, std::uint32_t offset) noexcept {
+                return current_block_kernels().to_uint32(words, reinterpret_cast<std::uint32_t*>(values), range, threshold, offset);
+            }
+        };
+        
+        /**
+         * Uniform floating point numbers built directly from the engine
+         * bits, instead of std::generate_canonical which may call the
+         * engine more than once. A float takes the high half of a 64 bits
+         * output, and the bulk fill uses both halves. Nothing is kept
+         * between two calls, so that copies of a distribution, and the
+         * distributions in use before seed() or fork(), never give out
+         * the same numbers.
+         * Unlike std::uniform_real_distribution, the output only depends
+         * on the engine output.
+         */
+        template <typename T>
+        class uniform_real_distribution {
+        public:
+            using result_type = T;
+            using word_type = typename canonical<T>::word_type;
+            
+            uniform_real_distribution(T min, T max) noexcept
+                : min_{min}, max_{max}, scale_{max - min}, limit_{std::nextafter(max, min)} {}
+            
+            result_type min() const noexcept { return min_; }
+            result_type max() const noexcept { return max_; }
+            
+            /**
+             * Generate a random number.
+             * @return - random number in the range [min, max).
+             */
+            template <typename Engine>
+            result_type operator()(Engine& engine) const {
+                return clamp_below(multiply_add(draw_canonical(engine, native<Engine>{}), scale_, min_), limit_);
+            }
+            
+            /**
+             * Fill [first, last) with random numbers. The engine output is
+             * generated by blocks, and converted by a vectorizable loop.
+             */
+            template <typename Engine>
+            void fill(Engine& engine, T* first, T* last) const {
+                fill(engine, first, last, native<Engine>{});
+            }
+            
+        private:
+            /**
+             * Whether the engine provides the canonical values itself.
+             */
+            template <typename Engine>
+            using native = std::integral_constant<bool, std::is_same<T, double>::value && has_close1_open2<Engine>::value>;
+            
+            template <typename Engine>
+            T draw_canonical(Engine& engine, std::false_type) const {
+                return canonical<T>::from_bits(bits<word_type>::draw(engine));
+            }
+            
+            template <typename Engine>
+            T draw_canonical(Engine& engine, std::true_type) const {
+                return engine.close1_open2() - T(1);
+            }
+            
+            template <typename Engine>
+            void fill(Engine& engine, T* first, T* last, std::true_type) const {
+                const auto scale = scale_;
+                const auto offset = min_;
+                const auto limit = limit_;
+                while (first != last) {
+                    const auto remaining = static_cast<std::size_t>(last - first);
+                    const auto count = remaining < block_size ? remaining : block_size;
+                    engine.fill_close1_open2(first, count);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        first[i] = clamp_below(multiply_add(first[i] - T(1), scale, offset), limit);
+                    }
+                    first += count;
+                }
+            }
+            
+            template <typename Engine>
+            void fill(Engine& engine, T* first, T* last, std::false_type) const {
+                const auto scale = scale_;
+                const auto offset = min_;
+                const auto limit = limit_;
+                fill_blocks<T, word_type>(engine, first, last, [=](const word_type* words, T* values, std::size_t count) {
+                    if (bulk_kernel<T>::available && count == block_words<word_type>::value) {
+                        bulk_kernel<T>::apply(words, values, scale, offset, limit);
+                        return;
+                    }
+                    for (std::size_t i = 0; i < count; ++i) {
+                        values[i] = clamp_below(multiply_add(canonical<T>::from_bits(words[i]), scale, offset), limit);
+                    }
+                });
+            }
+            
+            T min_;
+            T max_;
+            T scale_;
+            T limit_;
+        };
+        
+        /**
+         * Uniform distribution for integral types, with min and max
+         * passed as template parameters.
+         * @return - the uniform distribution.
+         */
+        template <
+            typename T,
+            T min = range<T>::min,
+            T max = range<T>::max,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0
+        >
+        auto uniform_distribution() {
+            return static_uniform_int_distribution<T, min, max>{};
+        }
+        
+        /**
+         * Uniform distribution for floating point types, with min and max
+         * passed as template parameters.
+         * @return - the uniform distribution.
+         */
+        template <
+            typename T,
+            long long min = range<T>::min,
+            long long max = range<T>::max,
+            typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0
+        >
+        auto uniform_distribution() {
+            return uniform_real_distribution<T>{static_cast<T>(min), static_cast<T>(max)};
+        }
+        
+        /**
+         * Uniform distribution for integral types, with min and max
+         * passed as function parameters.
+         * @return - the uniform distribution.
+         */
+        template <
+            typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0
+        >
+        auto uniform_distribution(T min, T max) {
+            return uniform_int_distribution<T>{min, max};
+        }
+        
+        /**
+         * Uniform distribution for floating point types, with min and max
+         * passed as function parameters.
+         * @return - the uniform distribution.
+         */
+        template <
+            typename T,
+            typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0
+        >
+        auto uniform_distribution(T min, T max) {
+            return uniform_real_distribution<T>{min, max};
+        }
+        
+        /**
+         * Implementation of random number generation with min and
+         * max as template parameters.
+         * @return - random number in the range [min, max].
+         */
+        template <
+            typename T,
+            typename range<T>::value_type min = range<T>::min,
+            typename range<T>::value_type max = range<T>::max,
+            typename Engine = default_engine
+        >
+        auto rand_impl() {
+            RANDOMIZE_ENGINE_STORAGE auto generator = uniform_distribution<T, min, max>();
+            return generator(shared_engine<Engine>());
+        }
+        
+        /**
+         * Thread-safe memoization cache, which holds at most a given
+         * number of entries, evicting them with CLOCK (second chance): a
+         * lookup sets the reference bit of its entry, and the hand of the
+         * shard clears the bits it passes, evicting the first entry whose
+         * bit is already clear. The entries are split across shards, each
+         * one with its own lock for the insertions, so that threads
+         * inserting different keys rarely contend. Each shard is a flat
+         * table with linear probing, kept at most half full, whose slots
+         * hold the keys and values themselves.
+         * Lookups take no lock, and only write to mark an entry as
+         * recently used when it is not already: each slot is a seqlock,
+         * which the lookups read optimistically, falling back to the lock
+         * of the shard when they race with a writer. The values are
+         * returned by copy, so they stay valid after their eviction. A
+         * shard which grows, up to its share of the capacity, publishes a
+         * bigger copy of its table and keeps the previous ones alive for
+         * the readers still in them, which at most doubles its memory use.
+         */
+        template <typename Key, typename Value>
+        class sharded_cache {
+            static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+                          "the keys and values are stored as words");
+            
+        public:
+            explicit sharded_cache(std::size_t capacity) noexcept
+                : limit_{std::max<std::size_t>((capacity + shard_count - 1) / shard_count, 1)} {}
+            
+            /**
+             * @return - the value of the key, inserted with make() if
+             * it is not there yet.
+             */
+            template <typename Factory>
+            Value find_or_emplace(const Key& key, std::uint64_t hash, Factory make) {
+                auto& s = shards_[hash % shard_count];
+                // The low bits pick the shard, and 0 marks the empty slots
+                hash |= 1;
+                key_words words;
+                save(key, words.data);
+                
+                value_words value;
+                if (find(s.current.load(std::memory_order_acquire), words, hash, value)) {
+                    count_hit();
+                    return load<Value>(value.data);
+                }
+                
+                std::lock_guard<std::mutex> lock(s.mutex);
+                auto current = s.owner.get();
+                if (find(current, words, hash, value)) {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return load<Value>(value.data);
+                }
+                misses_.fetch_add(1, std::memory_order_relaxed);
+                if (current != nullptr && current->size == limit_) {
+                    current->evict(s.hand);
+                    evictions_.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (current == nullptr || 2 * (current->size + 1) > current->capacity) {
+                    auto next = std::make_unique<table>(current == nullptr ? 16 : 2 * current->capacity);
+                    if (current != nullptr) {
+                        for (std::size_t i = 0; i < current->capacity; ++i) {
+                            const auto& entry = current->slots[i];
+                            const auto entry_hash = entry.hash.load(std::memory_order_relaxed);
+                            if (entry_hash != 0) {
+                                next->insert(entry_hash, entry.words);
+                            }
+                        }
+                    }
+                    next->previous = std::move(s.owner);
+                    s.owner = std::move(next);
+                    current = s.owner.get();
+                    s.hand = 0;
+                    s.current.store(current, std::memory_order_release);
+                }
+                
+                const auto result = make();
+                slot_words entry;
+                std::copy(std::begin(words.data), std::end(words.data), entry.data);
+                save(result, entry.data + key_size);
+                current->insert(hash, entry.data);
+                return result;
+            }
+            
+            /**
+             * @return - the hits, misses, evictions and size of the cache.
+             * The hits of the other threads are counted by batches.
+             */
+            cache_statistics statistics() {
+                auto& pending = pending_hits();
+                hits_.fetch_add(pending.count, std::memory_order_relaxed);
+                pending.count = 0;
+                
+                cache_statistics result{};
+                result.hits = hits_.load(std::memory_order_relaxed);
+                result.misses = misses_.load(std::memory_order_relaxed);
+                result.evictions = evictions_.load(std::memory_order_relaxed);
+                result.capacity = limit_ * shard_count;
+                for (auto& s : shards_) {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    result.size += s.owner == nullptr ? 0 : s.owner->size;
+                }
+                return result;
+            }
+            
+        private:
+            static constexpr std::size_t shard_count = 64;
+            static constexpr std::size_t key_size = (sizeof(Key) + 7) / 8;
+            static constexpr std::size_t value_size = (sizeof(Value) + 7) / 8;
+            
+            template <std::size_t Size>
+            struct words_of {
+                std::uint64_t data[Size];
+            };
+            
+            using key_words = words_of<key_size>;
+            using value_words = words_of<value_size>;
+            using slot_words = words_of<key_size + value_size>;
+            
+            template <typename U>
+            static void save(const U& value, std::uint64_t* words) noexcept {
+                std::uint64_t raw[(sizeof(U) + 7) / 8] = {};
+                std::memcpy(raw, &value, sizeof(U));
+                std::copy(std::begin(raw), std::end(raw), words);
+            }
+            
+            template <typename U>
+            static U load(const std::uint64_t* words) noexcept {
+                typename std::aligned_storage<sizeof(U), alignof(U)>::type storage;
+                std::memcpy(&storage, words, sizeof(U));
+                return *reinterpret_cast<const U*>(&storage);
+            }
+            
+            /**
+             * The key and value of a slot are only written while its
+             * sequence number is odd, so that a reader which sees the same
+             * even number before and after reading them got a consistent
+             * copy. They are stored with release and loaded with acquire,
+             * which are plain moves on x86, so that a reader which sees a
+             * new word also sees the odd sequence number.
+             */
+            struct slot {
+                std::atomic<std::uint32_t> sequence;
+                std::atomic<bool> referenced;
+                std::atomic<std::uint64_t> hash;
+                std::atomic<std::uint64_t> words[key_size + value_size];
+            };
+            
+            struct table {
+                explicit table(std::size_t slot_count) : capacity{slot_count}, size{0}, slots{new slot[slot_count]()} {}
+                
+                std::size_t home(std::uint64_t hash) const noexcept {
+                    return static_cast<std::size_t>(hash / shard_count) & (capacity - 1);
+                }
+                
+                std::size_t next(std::size_t i) const noexcept {
+                    return (i + 1) & (capacity - 1);
+                }
+                
+                void write(std::size_t i, std::uint64_t hash, const std::uint64_t* words) noexcept {
+                    auto& entry = slots[i];
+                    const auto sequence = entry.sequence.load(std::memory_order_relaxed);
+                    entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+                    entry.hash.store(hash, std::memory_order_release);
+                    for (std::size_t w = 0; w < key_size + value_size; ++w) {
+                        entry.words[w].store(words[w], std::memory_order_release);
+                    }
+                    entry.referenced.store(true, std::memory_order_relaxed);
+                    entry.sequence.store(sequence + 2, std::memory_order_release);
+                }
+                
+                void insert(std::uint64_t hash, const std::uint64_t* words) noexcept {
+                    auto i = home(hash);
+                    while (slots[i].hash.load(std::memory_order_relaxed) != 0) {
+                        i = next(i);
+                    }
+                    write(i, hash, words);
+                    ++size;
+                }
+                
+                void insert(std::uint64_t hash, const std::atomic<std::uint64_t>* words) noexcept {
+                    slot_words copy;
+                    for (std::size_t w = 0; w < key_size + value_size; ++w) {
+                        copy.data[w] = words[w].load(std::memory_order_relaxed);
+                    }
+                    insert(hash, copy.data);
+                }
+                
+                /**
+                 * Remove the first entry after the hand which was not used
+                 * since the hand last passed it, and fill the hole with the
+                 * next entries of its cluster which may move back.
+                 */
+                void evict(std::size_t& hand) noexcept {
+                    for (;; hand = next(hand)) {
+                        auto& entry = slots[hand];
+                        if (entry.hash.load(std::memory_order_relaxed) == 0) {
+                            continue;
+                        }
+                        if (entry.referenced.load(std::memory_order_relaxed)) {
+                            entry.referenced.store(false, std::memory_order_relaxed);
+                            continue;
+                        }
+                        break;
+                    }
+                    
+                    auto hole = hand;
+                    for (auto i = next(hole);; i = next(i)) {
+                        const auto hash = slots[i].hash.load(std::memory_order_relaxed);
+                        if (hash == 0) {
+                            break;
+                        }
+                        // The entry may move to the hole if its home is not in (hole, i]
+                        const auto distance = (i - home(hash)) & (capacity - 1);
+                        if (distance >= ((i - hole) & (capacity - 1))) {
+                            const auto referenced = slots[i].referenced.load(std::memory_order_relaxed);
+                            insert_at(hole, hash, slots[i].words, referenced);
+                            hole = i;
+                        }
+                    }
+                    const std::uint64_t empty[key_size + value_size] = {};
+                    write(hole, 0, empty);
+                    --size;
+                }
+                
+                void insert_at(std::size_t i, std::uint64_t hash, const std::atomic<std::uint64_t>* words, bool referenced) noexcept {
+                    slot_words copy;
+                    for (std::size_t w = 0; w < key_size + value_size; ++w) {
+                        copy.data[w] = words[w].load(std::memory_order_relaxed);
+                    }
+                    write(i, hash, copy.data);
+                    slots[i].referenced.store(referenced, std::memory_order_relaxed);
+                }
+                
+                std::size_t capacity;
+                std::size_t size;
+                std::unique_ptr<slot[]> slots;
+                std::unique_ptr<table> previous;
+            };
+            
+            struct alignas(64) shard {
+                std::atomic<table*> current{nullptr};
+                std::mutex mutex;
+                std::unique_ptr<table> owner;
+                std::size_t hand = 0;
+            };
+            
+            /**
+             * Look the key up without lock. It may miss an entry which is
+             * being moved, in which case the caller retries with the lock.
+             * @return - whether the value was found.
+             */
+            static bool find(table* current, const key_words& key, std::uint64_t hash, value_words& value) noexcept {
+                if (current == nullptr) {
+                    return false;
+                }
+                auto i = current->home(hash);
+                for (std::size_t probes = 0; probes < current->capacity; ++probes, i = current->next(i)) {
+                    auto& entry = current->slots[i];
+                    const auto sequence = entry.sequence.load(std::memory_order_acquire);
+                    const auto entry_hash = entry.hash.load(std::memory_order_acquire);
+                    if (entry_hash == 0) {
+                        return false;
+                    }
+                    if (entry_hash != hash) {
+                        continue;
+                    }
+                    bool equal = true;
+                    for (std::size_t w = 0; w < key_size; ++w) {
+                        equal &= entry.words[w].load(std::memory_order_acquire) == key.data[w];
+                    }
+                    if (!equal) {
+                        continue;
+                    }
+                    for (std::size_t w = 0; w < value_size; ++w) {
+                        value.data[w] = entry.words[key_size + w].load(std::memory_order_acquire);
+                    }
+                    if ((sequence & 1) != 0 || entry.sequence.load(std::memory_order_relaxed) != sequence) {
+                        return false;
+                    }
+                    if (!entry.referenced.load(std::memory_order_relaxed)) {
+                        entry.referenced.store(true, std::memory_order_relaxed);
+                    }
+                    return true;
+                }
+                return false;
+            }
+            
+            /**
+             * Hits found without lock, counted per thread, so that a
+             * lookup writes nothing shared.
+             */
+            struct hit_counter {
+                ~hit_counter() {
+                    if (total != nullptr) {
+                        total->fetch_add(count, std::memory_order_relaxed);
+                    }
+                }
+                
+                std::atomic<std::uint64_t>* total;
+                std::uint64_t count;
+            };
+            
+            hit_counter& pending_hits() noexcept {
+                thread_local hit_counter pending{&hits_, 0};
+                return pending;
+            }
+            
+            void count_hit() noexcept {
+                auto& pending = pending_hits();
+                if (++pending.count == 256) {
+                    hits_.fetch_add(pending.count, std::memory_order_relaxed);
+                    pending.count = 0;
+                }
+            }
+            
+            shard shards_[shard_count];
+            std::size_t limit_;
+            alignas(64) std::atomic<std::uint64_t> hits_{0};
+            std::atomic<std::uint64_t> misses_{0};
+            std::atomic<std::uint64_t> evictions_{0};
+        };
+        
+        /**
+         * Memoized distributions from which get_rand_impl builds
+         * its function objects, shared by all the threads and engines.
+         * @return - the distributions, indexed by (min, max).
+         */
+        template <typename T>
+        auto& get_rand_generators() {
+            using distrib_type = decltype(uniform_distribution<T>(T{}, T{}));
+            static sharded_cache<range_key<T>, distrib_type> generators{RANDOMIZE_GET_RAND_CAPACITY};
+            return generators;
+        }
+        
+        /**
+         * Gives access to the shared engine.
+         */
+        template <typename Engine>
+        struct shared_engine_source {
+            Engine& operator()() const {
+                return shared_engine<Engine>();
+            }
+        };
+        
+        /**
+         * Gives access to an engine owned by the generator. The engine
+         * is moved in, so that move-only engines, e.g. prefetched, can
+         * be owned.
+         */
+        template <typename Engine>
+        class owned_engine_source {
+        public:
+            explicit owned_engine_source(Engine engine) : engine_(std::move(engine)) {}
+            
+            Engine& operator()() {
+                return engine_;
+            }
+            
+        private:
+            Engine engine_;
+        };
+        
+        /**
+         * Generate a random number from the engine of a source.
+         * @return - the random number.
+         */
+        template <typename Distribution, typename EngineSource>
+        auto draw(Distribution& distribution, EngineSource& source) {
+            return distribution(source());
+        }
+        
+        /**
+         * A pooled distribution only reaches the engine when its pool
+         * is empty.
+         */
+        template <typename T, typename EngineSource>
+        T draw(pooled_int_distribution<T>& distribution, EngineSource& source) {
+            return distribution.draw(source);
+        }
+        
+        /**
+         * Random number function object returned by get_rand_impl.
+         * It holds its own copy of the distribution, so that a call is
+         * only the engine step plus the range reduction. The engine is
+         * reached through EngineSource, an empty function object, so
+         * the generator is not bigger than the distribution itself.
+         */
+        template <typename Distribution, typename EngineSource>
+        class generator : private EngineSource {
+        public:
+            using result_type = typename Distribution::result_type;
+            
+            explicit generator(const Distribution& distribution, EngineSource source = EngineSource{})
+                : EngineSource(std::move(source)), distribution_(distribution) {}
+            
+            result_type operator()() {
+                return draw(distribution_, static_cast<EngineSource&>(*this));
+            }
+            
+        private:
+            Distribution distribution_;
+        };
+        
+        /**
+         * Implementation of random number generation with min and
+         * max as function parameters. This version uses memoization
+         * technique and actually returns a function object.
+         * @return - random number function in the range [min, max].
+         */
+        template <typename T, typename Engine = default_engine>
+        auto get_rand_impl(T min, T max) {
+            using distrib_type = decltype(uniform_distribution<T>(min, max));
+            const range_key<T> key{min, max};
+            const auto distribution = get_rand_generators<T>().find_or_emplace(key, key.hash(), [min, max] { return uniform_distribution<T>(min, max); });
+            return generator<distrib_type, shared_engine_source<Engine>>{distribution};
+        }
+        
+        /**
+         * Implementation of random number generation with min and
+         * max as function parameters. The distribution is built on
+         * the fly, which is cheaper than memoizing it: varying bounds,
+         * as in a Fisher-Yates shuffle, neither hash nor grow the map.
+         * @return - random number in the range [min, max].
+         */
+        template <typename T, typename Engine = default_engine>
+        auto rand_impl(T min, T max) {
+            auto distribution = uniform_distribution<T>(min, max);
+            return distribution(shared_engine<Engine>());
+        }
+        
+        /**
+         * Implementation of pooled random number generation with min
+         * and max as template parameters. The pool is per instantiation,
+         * and per thread with RANDOMIZE_THREAD_LOCAL_ENGINES, like the
+         * engines.
+         * @return - random number in the range [min, max].
+         */
+        template <typename T, T min, T max, typename Engine>
+        T rand_impl(pooled_policy) {
+            RANDOMIZE_ENGINE_STORAGE static_pooled_int_distribution<T, min, max> generator;
+            return generator.draw(shared_engine_source<Engine>{});
+        }
+        
+        /**
+         * Whether an iterator to elements of type T is the iterator of
+         * std::basic_string<Char>.
+         */
+        template <typename Iterator, typename T, typename Char>
+        using is_string_iterator = std::integral_constant<bool,
+            std::is_same<T, Char>::value && std::is_same<Iterator, typename std::basic_string<Char>::iterator>::value>;
+        
         /**
-         * It is a pity, but there is no support
-         * for std::hash<std::pair<T1, T2>> in C++14
-         * when std::hash is defined for both T1 and 
-         * T2 so every library has to do it on its own.
-         * If you have Boost in your prerequisite, you
-         * just need to make sure to include 
-         * boost/functional/hash/pair.hpp before this
-         * file so that it uses it.
-         * If Boost is not used, a simple hash function
-         * is provided.
-         * Warning: the default function may overflow so
-         * you need to use Boost for a production usage.
+         * Whether an iterator to elements of type T is a pointer in
+         * disguise: the iterators of std::vector (but std::vector<bool>),
+         * std::array and the strings, which are classes with some standard
+         * libraries. Before C++20, there is no std::contiguous_iterator to
+         * tell it for any iterator.
          */
-        template <typename T>
-        struct hash_pair {
-            std::size_t operator()(const std::pair<T, T>& p) const {
-                #if defined(BOOST_FUNCTIONAL_HASH_PAIR_HPP)
-                    return boost::hash_value(p);
-                #else
-                    // Reference: Algorithms, 4th edition (Sedgewick, Wayne), p.462
-                    std::size_t hash{17};
-                    hash = hash * 31 + p.first;
-                    hash = hash * 31 + p.second;
-                    return (hash & 0x7fffffff) % 100003;
-                #endif
+        template <typename Iterator, typename T>
+        struct is_contiguous_iterator : std::integral_constant<bool,
+            !std::is_same<T, bool>::value && (
+                std::is_same<Iterator, typename std::vector<T>::iterator>::value ||
+                std::is_same<Iterator, typename std::array<T, 1>::iterator>::value ||
+                is_string_iterator<Iterator, T, char>::value ||
+                is_string_iterator<Iterator, T, wchar_t>::value ||
+                is_string_iterator<Iterator, T, char16_t>::value ||
+                is_string_iterator<Iterator, T, char32_t>::value)> {};
+        
+        /**
+         * Bulk generation straight into contiguous memory.
+         */
+        template <typename Distribution, typename Engine>
+        void fill_impl(typename Distribution::result_type* first, typename Distribution::result_type* last,
+                       const Distribution& distribution, Engine& engine) {
+            distribution.fill(engine, first, last);
+        }
+        
+        template <typename Iterator, typename Distribution, typename Engine>
+        void fill_impl(Iterator first, Iterator last, const Distribution& distribution, Engine& engine, std::true_type) {
+            if (first != last) {
+                const auto data = &*first;
+                fill_impl(data, data + (last - first), distribution, engine);
             }
+        }
+        
+        /**
+         * Bulk generation through an intermediate block, for any
+         * forward iterator.
+         */
+        template <typename Iterator, typename Distribution, typename Engine>
+        void fill_impl(Iterator first, Iterator last, const Distribution& distribution, Engine& engine, std::false_type) {
+            typename Distribution::result_type buffer[block_size];
+            auto count = static_cast<std::size_t>(std::distance(first, last));
+            while (count != 0) {
+                const auto n = count < block_size ? count : block_size;
+                distribution.fill(engine, buffer, buffer + n);
+                first = std::copy(buffer, buffer + n, first);
+                count -= n;
+            }
+        }
+        
+        /**
+         * Bulk generation into any forward iterator, straight into the
+         * memory it points to when it is contiguous.
+         */
+        template <typename Iterator, typename Distribution, typename Engine>
+        void fill_impl(Iterator first, Iterator last, const Distribution& distribution, Engine& engine) {
+            fill_impl(first, last, distribution, engine, is_contiguous_iterator<Iterator, typename Distribution::result_type>{});
+        }
+        
+        /**
+         * Number of elements generated from each stream by a parallel
+         * fill. It is independent from the number of threads, so that
+         * the output is the same whatever this number.
+         */
+        constexpr std::size_t parallel_chunk_size = std::size_t{1} << 16;
+        
+        /**
+         * Engine filling a chunk of a parallel fill: the engine itself,
+         * except for a prefetched engine, whose ring would be allocated
+         * and handed to the background thread for a single chunk. The
+         * buffered engine draws the same words without it.
+         */
+        template <typename Engine>
+        struct chunk_engine {
+            using type = Engine;
+        };
+        
+        template <typename Engine, std::size_t Size, std::size_t Blocks>
+        struct chunk_engine<engines::prefetched<Engine, Size, Blocks>> {
+            using type = engines::buffered<Engine, Size>;
         };
         
         /**
-         * Range structure for min/max type management.
+         * Parallel bulk generation: [first, last) is split into chunks of
+         * parallel_chunk_size elements, and chunk i is filled from the
+         * engine of stream i, see make_stream_engine. The threads,
+         * including the calling one, pick the chunks from a shared counter.
          */
-        template <typename T, typename TEnable = void>
-        struct range {};
+        template <typename Engine, typename Iterator, typename Distribution>
+        void parallel_fill_impl(Iterator first, Iterator last, const Distribution& distribution,
+                                unsigned threads, std::uint64_t seed) {
+            static_assert(std::is_base_of<std::random_access_iterator_tag,
+                                          typename std::iterator_traits<Iterator>::iterator_category>::value,
+                          "a parallel fill requires random access iterators");
+            
+            const auto count = static_cast<std::size_t>(last - first);
+            const auto chunks = (count + parallel_chunk_size - 1) / parallel_chunk_size;
+            std::atomic<std::size_t> next_chunk{0};
+            
+            auto work = [&] {
+                for (auto chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+                    const auto begin = chunk * parallel_chunk_size;
+                    const auto end = begin + parallel_chunk_size < count ? begin + parallel_chunk_size : count;
+                    auto engine = make_stream_engine<typename chunk_engine<Engine>::type>(seed, chunk);
+                    fill_impl(first + begin, first + end, distribution, engine);
+                }
+            };
+            
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            if (threads > chunks) {
+                threads = static_cast<unsigned>(chunks);
+            }
+            
+            std::vector<std::thread> workers;
+            for (unsigned i = 1; i < threads; ++i) {
+                try {
+                    workers.emplace_back(work);
+                } catch (const std::system_error&) {
+                    // Fewer threads only means less parallelism
+                    break;
+                }
+            }
+            work();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
         
         /**
-         * The default range for an integral type is simply
-         * its numeric limits.
+         * Ring of blocks filled by the prefetch thread, see
+         * engines::prefetched.
          */
-        template <typename T>
-        struct range<T, std::enable_if_t<std::is_integral<T>::value>> {
-            using type = T;
-            using value_type = T;
+        class prefetch_ring {
+        public:
+            virtual ~prefetch_ring() = default;
             
-            static constexpr const T actual_min = std::numeric_limits<T>::min();
-            static constexpr const T actual_max = std::numeric_limits<T>::max();
+            /**
+             * Generate the next block, unless the ring is full or its
+             * consumer is generating it.
+             * @return - whether a block was generated.
+             */
+            virtual bool produce() = 0;
             
-            static constexpr const T min = std::numeric_limits<T>::min();
-            static constexpr const T max = std::numeric_limits<T>::max();
+            /**
+             * Set when the consumer is gone.
+             */
+            std::atomic<bool> closed{false};
         };
         
         /**
-         * Template parameters do not support floating-point
-         * numbers. Hence, its range is limited to the long long type.
+         * Background thread filling the rings of the prefetched engines,
+         * one block per ring in turn. It polls them, and sleeps longer and
+         * longer while they are full, so that a consumer never has to wake
+         * it up. It waits for a new ring when all of them are closed. It
+         * is started with the first ring, and again in a child process
+         * after fork, where it does not exist anymore.
          */
-        template <typename T>
-        struct range<T, std::enable_if_t<std::is_floating_point<T>::value>> {
-            using type = T;
-            using value_type = long long;
+        class prefetcher {
+        public:
+            static prefetcher& instance() {
+                static prefetcher instance;
+                return instance;
+            }
             
-            static constexpr const T actual_min = std::numeric_limits<T>::min();
-            static constexpr const T actual_max = std::numeric_limits<T>::max();
+            prefetcher(const prefetcher&) = delete;
+            prefetcher& operator=(const prefetcher&) = delete;
             
-            // Limitation: if you need a larger range, use the function parameter version
-            static constexpr const value_type min = std::numeric_limits<value_type>::min();
-            static constexpr const value_type max = std::numeric_limits<value_type>::max();
+            ~prefetcher() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                stop_ = true;
+                wakeup_->notify_one();
+                stopped_.wait(lock, [this] { return !running_; });
+            }
+            
+            void add(std::shared_ptr<prefetch_ring> ring) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                rings_.push_back(std::move(ring));
+                wakeup_->notify_one();
+                if (!running_) {
+                    try {
+                        std::thread([this] { run(); }).detach();
+                        running_ = true;
+                    } catch (const std::system_error&) {
+                        // The consumers generate their blocks themselves
+                    }
+                }
+            }
+            
+        private:
+            prefetcher() {
+                #if defined(RANDOMIZE_ATFORK)
+                    // The thread holds the mutex while it generates, so
+                    // that no ring is locked by a thread lost on fork
+                    pthread_atfork(
+                        [] {
+                            instance().mutex_.lock();
+                        },
+                        [] {
+                            instance().mutex_.unlock();
+                        },
+                        [] {
+                            // The thread may have been waiting on wakeup_,
+                            // which cannot be notified nor destroyed with
+                            // a waiter which is gone: it is leaked
+                            static_cast<void>(instance().wakeup_.release());
+                            instance().wakeup_.reset(new std::condition_variable);
+                            instance().running_ = false;
+                            instance().mutex_.unlock();
+                        });
+                #endif
+            }
+            
+            void run() {
+                const auto max_pause = std::chrono::microseconds(1000);
+                auto pause = std::chrono::microseconds(0);
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (!stop_) {
+                    rings_.erase(std::remove_if(std::begin(rings_), std::end(rings_),
+                                                [](const std::shared_ptr<prefetch_ring>& ring) {
+                                                    return ring->closed.load(std::memory_order_relaxed);
+                                                }),
+                                 std::end(rings_));
+                    if (rings_.empty()) {
+                        wakeup_->wait(lock, [this] { return stop_ || !rings_.empty(); });
+                        pause = std::chrono::microseconds(0);
+                        continue;
+                    }
+                    auto produced = false;
+                    for (auto& ring : rings_) {
+                        produced = ring->produce() || produced;
+                    }
+                    pause = produced ? std::chrono::microseconds(0)
+                                     : std::min(std::max(2 * pause, std::chrono::microseconds(10)), max_pause);
+                    lock.unlock();
+                    if (produced) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(pause);
+                    }
+                    lock.lock();
+                }
+                running_ = false;
+                stopped_.notify_all();
+            }
+            
+            std::mutex mutex_;
+            std::unique_ptr<std::condition_variable> wakeup_{new std::condition_variable};
+            std::condition_variable stopped_;
+            std::vector<std::shared_ptr<prefetch_ring>> rings_;
+            bool running_ = false;
+            bool stop_ = false;
         };
-        
+    }
+    
+    namespace engines {
         /**
-         * Generate a unique seed based on the current time of day.
-         * @return - a seed to feed to a random number generator.
+         * Adaptor which draws the outputs of an engine by blocks of Size
+         * 64 bits words into a cache-aligned buffer, with generate_block
+         * when the engine provides it, so that a draw only reads the
+         * buffer. The words are the same as those of the engine, two
+         * outputs making a word for a 32 bits engine.
+         * The buffer is refilled when empty, on the path of a draw, unless
+         * refill() tops it up beforehand, e.g. while idle:
+         * randomize::engines::buffered<std::mt19937_64> engine{seed};
          */
-        unsigned gen_seed() noexcept {
-            using seed_time_t = std::chrono::high_resolution_clock;
-            auto seed_time = seed_time_t::now().time_since_epoch().count();
-            return static_cast<unsigned>(seed_time);
-        }
+        template <typename Engine, std::size_t Size>
+        class buffered {
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            buffered() = default;
+            
+            /**
+             * Construct the engine from the arguments, e.g. a seed, a seed
+             * and a stream, or a seed sequence.
+             */
+            template <typename Arg, typename... Args,
+                      typename std::enable_if<std::is_constructible<Engine, Arg&&, Args&&...>::value, int>::type = 0>
+            explicit buffered(Arg&& arg, Args&&... args) : engine_(std::forward<Arg>(arg), std::forward<Args>(args)...) {}
+            
+            result_type operator()() {
+                if (RANDOMIZE_UNLIKELY(index_ == Size)) {
+                    refill();
+                }
+                return buffer_[index_++];
+            }
+            
+            /**
+             * @return - the number of words left in the buffer.
+             */
+            std::size_t available() const noexcept {
+                return Size - index_;
+            }
+            
+            /**
+             * Top the buffer up, keeping the words left in order, so that
+             * the next Size draws do not call the engine.
+             */
+            RANDOMIZE_NOINLINE void refill() {
+                const auto left = Size - index_;
+                std::copy(buffer_ + index_, buffer_ + Size, buffer_);
+                details::generate_block(engine_, buffer_ + left, Size - left);
+                index_ = 0;
+            }
+            
+            /**
+             * Write the next count words: the buffer is used up, and the
+             * whole blocks are generated in place.
+             */
+            void generate_block(std::uint64_t* first, std::size_t count) {
+                const auto buffered_words = std::min(count, Size - index_);
+                first = std::copy(buffer_ + index_, buffer_ + index_ + buffered_words, first);
+                index_ += buffered_words;
+                count -= buffered_words;
+                const auto direct = count - count % Size;
+                details::generate_block(engine_, first, direct);
+                for (auto last = first + count, it = first + direct; it != last; ++it) {
+                    *it = (*this)();
+                }
+            }
+            
+        private:
+            Engine engine_;
+            std::size_t index_ = Size;
+            alignas(64) std::uint64_t buffer_[Size] = {};
+        };
         
         /**
-         * Uniform distribution for integral types, with min and max
-         * passed as template parameters.
-         * @return - the uniform distribution.
+         * Adaptor whose blocks of Size 64 bits words are generated ahead
+         * by a background thread, into a ring of Blocks blocks per
+         * prefetched engine, i.e. per consumer thread with thread-local
+         * engines. A draw reads the current block in place, and only
+         * synchronizes with the thread once per block, with two atomic
+         * operations. When the ring runs dry, the consumer generates the
+         * next block itself, so that the words are always those of the
+         * engine, in order, whether the thread keeps up or not.
+         * With one core, the thread only runs while the consumers wait,
+         * e.g. for I/O between two requests:
+         * #define RANDOMIZE_DEFAULT_ENGINE randomize::engines::prefetched<std::mt19937_64>
+         * An engine which is not shared by rand and get_rand must not be
+         * used in a child process after fork, since its ring is not
+         * replaced there.
          */
-        template <
-            typename T,
-            T min = range<T>::min,
-            T max = range<T>::max,
-            typename std::enable_if<std::is_integral<T>::value, int>::type = 0
-        >
-        auto uniform_distribution() {
-            return std::uniform_int_distribution<T>{min, max};
+        template <typename Engine, std::size_t Size, std::size_t Blocks>
+        class prefetched {
+            static_assert(Size != 0 && Blocks >= 2, "a ring holds at least two blocks");
+            
+        public:
+            using result_type = std::uint64_t;
+            
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+            
+            prefetched() : prefetched(std::make_shared<ring>()) {}
+            
+            /**
+             * Construct the engine from the arguments, e.g. a seed, a seed
+             * and a stream, or a seed sequence.
+             */
+            template <typename Arg, typename... Args,
+                      typename std::enable_if<std::is_constructible<Engine, Arg&&, Args&&...>::value, int>::type = 0>
+            explicit prefetched(Arg&& arg, Args&&... args)
+                : prefetched(std::make_shared<ring>(std::forward<Arg>(arg), std::forward<Args>(args)...)) {}
+            
+            prefetched(prefetched&& other) noexcept
+                : ring_(std::move(other.ring_)), current_(other.current_), index_(other.index_), block_(other.block_) {}
+            
+            prefetched& operator=(prefetched&& other) noexcept {
+                if (this != &other) {
+                    close();
+                    ring_ = std::move(other.ring_);
+                    current_ = other.current_;
+                    index_ = other.index_;
+                    block_ = other.block_;
+                }
+                return *this;
+            }
+            
+            ~prefetched() {
+                close();
+            }
+            
+            result_type operator()() {
+                if (RANDOMIZE_UNLIKELY(index_ == Size)) {
+                    next_block();
+                }
+                return current_[index_++];
+            }
+            
+        private:
+            /**
+             * The engine and its blocks. Block n is written to slot
+             * n % Blocks by whoever holds the mutex, and published by
+             * head, and given back by tail once read.
+             */
+            struct ring : details::prefetch_ring {
+                template <typename... Args>
+                explicit ring(Args&&... args) : engine(std::forward<Args>(args)...) {}
+                
+                bool produce() override {
+                    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+                    return lock.owns_lock() && generate();
+                }
+                
+                /**
+                 * Generate the next block, with the mutex held.
+                 * @return - whether there was room for it.
+                 */
+                bool generate() {
+                    const auto n = head.load(std::memory_order_relaxed);
+                    if (n - tail.load(std::memory_order_acquire) == Blocks) {
+                        return false;
+                    }
+                    details::generate_block(engine, blocks[n % Blocks], Size);
+                    head.store(n + 1, std::memory_order_release);
+                    return true;
+                }
+                
+                std::mutex mutex;
+                Engine engine;
+                std::atomic<std::size_t> head{0};
+                char padding[64];
+                std::atomic<std::size_t> tail{0};
+                std::uint64_t blocks[Blocks][Size];
+            };
+            
+            explicit prefetched(std::shared_ptr<ring> r) : ring_(std::move(r)) {
+                details::prefetcher::instance().add(ring_);
+            }
+            
+            /**
+             * Give the block read back, and move to the next one, which is
+             * generated here if the thread did not.
+             */
+            RANDOMIZE_NOINLINE void next_block() {
+                auto& r = *ring_;
+                r.tail.store(block_, std::memory_order_release);
+                if (r.head.load(std::memory_order_acquire) == block_) {
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    if (r.head.load(std::memory_order_relaxed) == block_) {
+                        r.generate();
+                    }
+                }
+                current_ = r.blocks[block_ % Blocks];
+                ++block_;
+                index_ = 0;
+            }
+            
+            void close() noexcept {
+                if (ring_) {
+                    ring_->closed.store(true, std::memory_order_relaxed);
+                    ring_.reset();
+                }
+            }
+            
+            std::shared_ptr<ring> ring_;
+            const std::uint64_t* current_ = nullptr;
+            std::size_t index_ = Size;
+            std::size_t block_ = 0;
+        };
+    }
+    
+    namespace details {
+        /**
+         * Whether an engine can top its buffer up with refill().
+         */
+        template <typename Engine, typename TEnable = void>
+        struct has_refill : std::false_type {};
+        
+        template <typename Engine>
+        struct has_refill<Engine, decltype(std::declval<Engine&>().refill(), void())> : std::true_type {};
+        
+        template <typename Engine>
+        void refill(std::true_type) {
+            shared_engine<Engine>().refill();
         }
         
+        template <typename Engine>
+        void refill(std::false_type) {}
+    }
+    
+    /**
+     * Top up the buffer of the engine used by rand and get_rand in the
+     * calling thread, when it is an engines::buffered, so that the draws
+     * which follow do not have to, e.g. between two requests. It does
+     * nothing for the other engines.
+     */
+    template <typename Engine = default_engine>
+    void refill() {
+        details::refill<Engine>(details::has_refill<Engine>{});
+    }
+    
+    /**
+     * Execution policy requesting a parallel fill. The output only
+     * depends on the seed, not on the number of threads. When no seed
+     * is given, it is drawn from the engine of the calling thread.
+     * Example: randomize::fill(randomize::par.seed(42), v, 0.f, 1.f).
+     */
+    class parallel_policy {
+    public:
+        constexpr parallel_policy() noexcept = default;
+        
         /**
-         * Uniform distribution for floating point types, with min and max
-         * passed as template parameters.
-         * @return - the uniform distribution.
+         * @return - the same policy, with a given number of threads
+         * (0 means std::thread::hardware_concurrency).
          */
-        template <
-            typename T,
-            long long min = range<T>::min,
-            long long max = range<T>::max,
-            typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0
-        >
-        auto uniform_distribution() {
-            return std::uniform_real_distribution<T>{static_cast<T>(min), static_cast<T>(max)};
+        constexpr parallel_policy threads(unsigned threads) const noexcept {
+            return parallel_policy{threads, seed_, seeded_};
         }
         
         /**
-         * Uniform distribution for integral types, with min and max
-         * passed as function parameters.
-         * @return - the uniform distribution.
+         * @return - the same policy, with a given seed.
          */
-        template <
-            typename T,
-            typename std::enable_if<std::is_integral<T>::value, int>::type = 0
-        >
-        auto uniform_distribution(T min, T max) {
-            return std::uniform_int_distribution<T>{min, max};
+        constexpr parallel_policy seed(std::uint64_t seed) const noexcept {
+            return parallel_policy{threads_, seed, true};
         }
         
+        constexpr unsigned threads() const noexcept { return threads_; }
+        constexpr bool seeded() const noexcept { return seeded_; }
+        constexpr std::uint64_t seed() const noexcept { return seed_; }
+        
+    private:
+        constexpr parallel_policy(unsigned threads, std::uint64_t seed, bool seeded) noexcept
+            : threads_{threads}, seed_{seed}, seeded_{seeded} {}
+        
+        unsigned threads_{0};
+        std::uint64_t seed_{0};
+        bool seeded_{false};
+    };
+    
+    /**
+     * Default parallel policy: all the hardware threads.
+     */
+    constexpr parallel_policy par{};
+    
+    /**
+     * Node of a tree of seeds: the seed of a child is a hash of the seed
+     * of its parent and of its index, or name, so that the stream of
+     * e.g. a task is a pure function of the root seed and of the path
+     * to the task, whatever the order in which the tasks are created.
+     * Example: auto task = randomize::seed_tree{42}.child("pool").child(i);
+     */
+    class seed_tree {
+    public:
         /**
-         * Uniform distribution for floating point types, with min and max
-         * passed as function parameters.
-         * @return - the uniform distribution.
+         * The root of the tree of the global seed.
          */
-        template <
-            typename T,
-            typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0
-        >
-        auto uniform_distribution(T min, T max) {
-            return std::uniform_real_distribution<T>{min, max};
-        }
+        seed_tree() noexcept : seed_{details::base_seed()} {}
+        
+        explicit constexpr seed_tree(std::uint64_t seed) noexcept : seed_{seed} {}
         
         /**
-         * Implementation of random number generation with min and
-         * max as template parameters.
-         * @return - random number in the range [min, max].
+         * @return - the child of a given index.
          */
-        template <
-            typename T,
-            typename range<T>::value_type min = range<T>::min,
-            typename range<T>::value_type max = range<T>::max
-        >
-        auto rand_impl() {
-            static unsigned seed_time{gen_seed()};
-            static auto generator = uniform_distribution<T, min, max>();
-            static auto engine = std::mt19937_64{seed_time};
-            return generator(engine);
+        constexpr seed_tree child(std::uint64_t index) const noexcept {
+            return seed_tree{details::stream_seed(seed_, index)};
         }
         
         /**
-         * Implementation of random number generation with min and
-         * max as function parameters. This version uses memoization
-         * technique and actually returns a function.
-         * @return - random number function in the range [min, max].
+         * @return - the child of a given name, e.g. a call site.
          */
-        template <typename T>
-        auto get_rand_impl(T min, T max) {
-            static unsigned seed_time{gen_seed()};
-            static auto engine = std::mt19937_64{seed_time};
-            
-            using distrib_type = decltype(uniform_distribution<T>(min, max));
-            using gen_hashmap = std::unordered_map<std::pair<T, T>, distrib_type, hash_pair<T>>;
-            static auto generators = gen_hashmap{};
-            
-            const auto key = std::make_pair(min, max);
-            generators.emplace(key, uniform_distribution<T>(min, max));
-            
-            auto f = [key] {
-                return generators[key](engine);
-            };
-            
-            return f;
+        seed_tree child(const char* name) const noexcept {
+            // FNV-1a
+            std::uint64_t hash = 0xcbf29ce484222325ULL;
+            for (; *name != '\0'; ++name) {
+                hash = (hash ^ static_cast<unsigned char>(*name)) * 0x100000001b3ULL;
+            }
+            return child(hash);
         }
         
+        constexpr std::uint64_t seed() const noexcept { return seed_; }
+        
         /**
-         * Implementation of random number generation with min and
-         * max as function parameters.
-         * @return - random number in the range [min, max].
+         * @return - an engine seeded from the node: counter-based engines
+         * take the seed as key, the others are seeded with a hash of it.
          */
-        template <typename T>
-        auto rand_impl(T min, T max) {
-            auto f = get_rand_impl(min, max);
-            return f();
+        template <typename Engine = default_engine>
+        Engine engine() const {
+            return details::make_stream_engine<Engine>(seed_, 0);
         }
-    }
+        
+        friend constexpr bool operator==(const seed_tree& lhs, const seed_tree& rhs) noexcept {
+            return lhs.seed_ == rhs.seed_;
+        }
+        
+        friend constexpr bool operator!=(const seed_tree& lhs, const seed_tree& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+        
+    private:
+        std::uint64_t seed_;
+    };
     
     /**
      * Random number generation with min and
      * max as function parameters.
+     * The engine may be chosen explicitly, e.g.
+     * rand<int, engines::xoshiro256starstar>(1, 6).
      * @return - random number in the range [min, max].
      */
-    template <typename T>
+    template <typename T, typename Engine = default_engine>
     auto rand(T min, T max) {
         static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
-        return details::rand_impl<T>(min, max);
+        return details::rand_impl<T, Engine>(min, max);
     }
 
     /**
@@ -220,10 +4825,121 @@ namespace randomize {
      * max as function parameters.
      * @return - random number function in the range [min, max].
      */
-    template <typename T>
+    template <typename T, typename Engine = default_engine>
     auto get_rand(T min, T max) {
         static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
-        return details::get_rand_impl<T>(min, max);
+        return details::get_rand_impl<T, Engine>(min, max);
+    }
+    
+    /**
+     * Pooled random number generation with min and max as function
+     * parameters: the function object keeps the draws left in the last
+     * word of the engine, and a copy of it starts without any. The
+     * distribution is built directly, without the memoization cache.
+     * @return - random number function in the range [min, max].
+     */
+    template <typename T, typename Engine = default_engine>
+    auto get_rand(pooled_policy, T min, T max) {
+        static_assert(std::is_integral<T>::value, "the provided type must be integral");
+        using distrib_type = details::pooled_int_distribution<T>;
+        return details::generator<distrib_type, details::shared_engine_source<Engine>>{distrib_type{min, max}};
+    }
+    
+    /**
+     * The function objects returned by get_rand hold their own copy of
+     * the distribution, so they stay valid after it is evicted.
+     * @return - the counters of the cache of the distributions of type T
+     * memoized by get_rand.
+     */
+    template <typename T>
+    cache_statistics get_rand_statistics() {
+        static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
+        return details::get_rand_generators<T>().statistics();
+    }
+    
+    /**
+     * Random number generation with min and max as function
+     * parameters, from a node of a seed tree. The function object owns
+     * its engine, seeded from the node: it shares no state with the
+     * others, and is cheap to create with a counter-based engine, e.g.
+     * get_rand<int, engines::philox4x32>(task, 1, 6).
+     * @return - random number function in the range [min, max].
+     */
+    template <typename T, typename Engine = default_engine>
+    auto get_rand(const seed_tree& node, T min, T max) {
+        static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
+        using distrib_type = decltype(details::uniform_distribution<T>(min, max));
+        using source_type = details::owned_engine_source<Engine>;
+        return details::generator<distrib_type, source_type>{details::uniform_distribution<T>(min, max), source_type{node.engine<Engine>()}};
+    }
+    
+    /**
+     * Fill [first, last) with random numbers in the range [min, max].
+     * This is much faster than std::generate with get_rand: the engine
+     * output is generated by blocks, and the range reduction is done by
+     * a tight loop. Raw pointers and the iterators of std::vector,
+     * std::array and the strings are written directly, the other
+     * iterators through a buffer.
+     */
+    template <typename T, typename Engine = default_engine, typename Iterator>
+    void fill(Iterator first, Iterator last, T min, T max) {
+        static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
+        details::fill_impl(first, last, details::uniform_distribution<T>(min, max), details::shared_engine<Engine>());
+    }
+    
+    /**
+     * Fill a contiguous container, or a span, with random numbers
+     * in the range [min, max].
+     */
+    template <typename T, typename Engine = default_engine, typename Container>
+    auto fill(Container&& container, T min, T max) -> decltype(container.data(), container.size(), void()) {
+        static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
+        auto first = container.data();
+        details::fill_impl(first, first + container.size(), details::uniform_distribution<T>(min, max), details::shared_engine<Engine>());
+    }
+    
+    /**
+     * Fill [first, last) with random numbers in the range [min, max],
+     * using several threads. Each chunk of the range is filled from its
+     * own stream, so the output is the same whatever the number of threads.
+     */
+    template <typename T, typename Engine = default_engine, typename Iterator>
+    void fill(const parallel_policy& policy, Iterator first, Iterator last, T min, T max) {
+        static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
+        const auto seed = policy.seeded() ? policy.seed() : details::bits64(details::shared_engine<Engine>());
+        details::parallel_fill_impl<Engine>(first, last, details::uniform_distribution<T>(min, max), policy.threads(), seed);
+    }
+    
+    /**
+     * Fill a contiguous container, or a span, with random numbers in
+     * the range [min, max], using several threads.
+     */
+    template <typename T, typename Engine = default_engine, typename Container>
+    auto fill(const parallel_policy& policy, Container&& container, T min, T max)
+        -> decltype(container.data(), container.size(), void()) {
+        auto first = container.data();
+        fill<T, Engine>(policy, first, first + container.size(), min, max);
+    }
+    
+    /**
+     * Seed all the engines used by rand, get_rand and fill, in every
+     * thread, from a given seed: each one is reseeded on its next use,
+     * and the engines only depend on the seed and on the order in which
+     * they are first used, e.g. to replay a run. The RANDOMIZE_SEED
+     * environment variable sets the seed at startup.
+     */
+    inline void seed(std::uint64_t seed) noexcept {
+        details::reseed(details::expand_seed(seed));
+    }
+    
+    /**
+     * Skip n outputs of an engine: in O(log n) with the engines which
+     * provide discard_fast, such as the xoshiro, pcg64 and SFMT ones,
+     * and std::mt19937_64, and with discard otherwise.
+     */
+    template <typename Engine>
+    void discard_fast(Engine& engine, unsigned long long n) {
+        details::discard_fast(engine, n, details::has_discard_fast<Engine>{});
     }
     
     /**
@@ -234,11 +4950,28 @@ namespace randomize {
     template <
         typename T,
         typename details::range<T>::value_type min = details::range<T>::min,
-        typename details::range<T>::value_type max = details::range<T>::max
+        typename details::range<T>::value_type max = details::range<T>::max,
+        typename Engine = default_engine
     >
     auto rand() {
         static_assert(std::is_arithmetic<T>::value, "the provided type must be arithmetic");
-        return details::rand_impl<T, min, max>();
+        return details::rand_impl<T, min, max, Engine>();
+    }
+    
+    /**
+     * Pooled random number generation with min and max as template
+     * parameters, e.g. rand<int, 1, 6>(randomize::pooled).
+     * @return - random number in the range [min, max].
+     */
+    template <
+        typename T,
+        T min = details::range<T>::min,
+        T max = details::range<T>::max,
+        typename Engine = default_engine
+    >
+    T rand(pooled_policy policy) {
+        static_assert(std::is_integral<T>::value, "the provided type must be integral");
+        return details::rand_impl<T, min, max, Engine>(policy);
     }
 }
 
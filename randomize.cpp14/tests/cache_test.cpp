@@ -0,0 +1,96 @@
+// Check the sharded_cache behind get_rand: threads looking keys up and
+// inserting them while the shards evict always get the value of their
+// key, and the statistics add up; an eviction which moves an entry back
+// across the end of its table, with the CLOCK hand, keeps the entries of
+// the cluster reachable.
+// g++ -std=c++14 -I.. cache_test.cpp -pthread
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    using cache = details::sharded_cache<std::uint64_t, std::uint64_t>;
+    
+    std::uint64_t value_of(std::uint64_t key) {
+        return key * 0x9e3779b97f4a7c15 + 1;
+    }
+    
+    void check_concurrent() {
+        constexpr std::size_t keys = 4096;
+        constexpr std::size_t lookups = 100000;
+        constexpr unsigned threads = 8;
+        cache c{256};
+        std::atomic<bool> wrong{false};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&c, &wrong, t] {
+                auto engine = engines::splitmix64{t};
+                for (std::size_t i = 0; i < lookups; ++i) {
+                    // A few hot keys, which are hits, and many cold ones
+                    const auto key = engine() % (i % 2 == 0 ? 32 : keys);
+                    const auto value = c.find_or_emplace(key, details::mix64(key), [key] { return value_of(key); });
+                    if (value != value_of(key)) {
+                        wrong = true;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        check(!wrong, "concurrent, values of the keys");
+        
+        const auto statistics = c.statistics();
+        check(statistics.hits + statistics.misses == threads * lookups, "concurrent, hits and misses");
+        check(statistics.size <= statistics.capacity && statistics.capacity == 256, "concurrent, size");
+        check(statistics.evictions == statistics.misses - statistics.size, "concurrent, evictions");
+        check(statistics.hits > threads * lookups / 4, "concurrent, hot keys hit");
+    }
+    
+    /**
+     * Find or insert a key of shard 0 whose home slot is given.
+     * @return - whether it was found.
+     */
+    bool find(cache& c, std::uint64_t key, std::size_t home) {
+        bool found = true;
+        const auto value = c.find_or_emplace(key, 64 * home, [key, &found] {
+            found = false;
+            return value_of(key);
+        });
+        return found && value == value_of(key);
+    }
+    
+    void check_wrap_around() {
+        // 3 entries per shard, in tables of 16 slots
+        cache c{3 * 64};
+        find(c, 1, 0);   // slot 0
+        find(c, 2, 15);  // slot 15
+        find(c, 3, 15);  // slot 1
+        
+        // The hand clears every entry, then evicts 1 at slot 0: 3 moves
+        // back to slot 0, unreferenced
+        find(c, 4, 5);
+        check(find(c, 3, 15), "3 moved to slot 0");
+        
+        // The hand clears 3 and 4, and evicts 2 at slot 15: 3 moves back
+        // across the end of the table to its home
+        find(c, 5, 7);
+        check(find(c, 3, 15), "3 moved to slot 15");
+        check(find(c, 4, 5) && find(c, 5, 7), "other entries");
+        check(!find(c, 2, 15), "2 evicted");
+        check(!find(c, 1, 0), "1 evicted");
+    }
+}
+
+int main() {
+    check_concurrent();
+    check_wrap_around();
+    return test::report();
+}
@@ -0,0 +1,142 @@
+// Known answer tests of the ChaCha engines: the block function and the
+// keystream of RFC 8439 (sections 2.3.2 and 2.4.2) for ChaCha20, and the
+// keystream of the all zero key and nonce for ChaCha8, ChaCha12 and
+// ChaCha20 (RFC 8439 appendix A.1, and the test vectors of
+// draft-strombergson-chacha-test-vectors-01).
+// g++ -std=c++14 -I.. chacha_test.cpp -pthread
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    /**
+     * The outputs of the engines are the keystream read as little
+     * endian 64 bits words.
+     * @return - the first count bytes of the keystream.
+     */
+    template <typename Engine>
+    std::vector<unsigned char> keystream(Engine& engine, std::size_t count) {
+        std::vector<unsigned char> bytes;
+        while (bytes.size() < count) {
+            const auto word = engine();
+            for (int i = 0; i < 8 && bytes.size() < count; ++i) {
+                bytes.push_back(static_cast<unsigned char>(word >> (8 * i)));
+            }
+        }
+        return bytes;
+    }
+    
+    void compare(const char* name, const std::vector<unsigned char>& actual, const std::vector<unsigned char>& expected) {
+        const auto ok = actual == expected;
+        std::printf("%-44s %s\n", name, ok ? "ok" : "MISMATCH");
+        test::check(ok, name);
+    }
+    
+    /**
+     * The key 00:01:02:...:1f of the RFC.
+     */
+    void rfc_key(std::uint32_t (&key)[8]) {
+        for (std::uint32_t i = 0; i < 8; ++i) {
+            key[i] = (4 * i) | (4 * i + 1) << 8 | (4 * i + 2) << 16 | (4 * i + 3) << 24;
+        }
+    }
+}
+
+int main() {
+    std::uint32_t key[8];
+    
+    // RFC 8439 2.3.2: block 1 of nonce 00:00:00:09:00:00:00:4a:00:00:00:00.
+    // The engine has the 64 bits counter and stream of the original
+    // ChaCha: the first nonce word is the high half of the counter.
+    {
+        rfc_key(key);
+        randomize::engines::chacha20 engine{key, 0x4a000000};
+        engine.discard(8 * (1 | std::uint64_t{0x09000000} << 32));
+        compare("ChaCha20 block function (RFC 8439 2.3.2)", keystream(engine, 64), {
+            0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+            0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+            0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+            0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+        });
+    }
+    
+    // RFC 8439 2.4.2: encryption from block 1 of nonce
+    // 00:00:00:00:00:00:00:4a:00:00:00:00
+    {
+        rfc_key(key);
+        randomize::engines::chacha20 engine{key, 0x4a000000};
+        engine.discard(8);
+        const char plaintext[] = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip "
+                                 "for the future, sunscreen would be it.";
+        auto ciphertext = keystream(engine, std::strlen(plaintext));
+        for (std::size_t i = 0; i < ciphertext.size(); ++i) {
+            ciphertext[i] ^= static_cast<unsigned char>(plaintext[i]);
+        }
+        compare("ChaCha20 encryption (RFC 8439 2.4.2)", ciphertext, {
+            0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80, 0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81,
+            0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2, 0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b,
+            0xf9, 0x1b, 0x65, 0xc5, 0x52, 0x47, 0x33, 0xab, 0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+            0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab, 0x8f, 0x53, 0x0c, 0x35, 0x9f, 0x08, 0x61, 0xd8,
+            0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61, 0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e,
+            0x52, 0xbc, 0x51, 0x4d, 0x16, 0xcc, 0xf8, 0x06, 0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+            0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6, 0xb4, 0x0b, 0x8e, 0xed, 0xf2, 0x78, 0x5e, 0x42,
+            0x87, 0x4d
+        });
+    }
+    
+    // All zero key and nonce, block 0
+    const std::uint32_t zero[8] = {};
+    {
+        randomize::engines::chacha8 engine{zero};
+        compare("ChaCha8 zero key", keystream(engine, 64), {
+            0x3e, 0x00, 0xef, 0x2f, 0x89, 0x5f, 0x40, 0xd6, 0x7f, 0x5b, 0xb8, 0xe8, 0x1f, 0x09, 0xa5, 0xa1,
+            0x2c, 0x84, 0x0e, 0xc3, 0xce, 0x9a, 0x7f, 0x3b, 0x18, 0x1b, 0xe1, 0x88, 0xef, 0x71, 0x1a, 0x1e,
+            0x98, 0x4c, 0xe1, 0x72, 0xb9, 0x21, 0x6f, 0x41, 0x9f, 0x44, 0x53, 0x67, 0x45, 0x6d, 0x56, 0x19,
+            0x31, 0x4a, 0x42, 0xa3, 0xda, 0x86, 0xb0, 0x01, 0x38, 0x7b, 0xfd, 0xb8, 0x0e, 0x0c, 0xfe, 0x42
+        });
+    }
+    {
+        randomize::engines::chacha12 engine{zero};
+        compare("ChaCha12 zero key", keystream(engine, 64), {
+            0x9b, 0xf4, 0x9a, 0x6a, 0x07, 0x55, 0xf9, 0x53, 0x81, 0x1f, 0xce, 0x12, 0x5f, 0x26, 0x83, 0xd5,
+            0x04, 0x29, 0xc3, 0xbb, 0x49, 0xe0, 0x74, 0x14, 0x7e, 0x00, 0x89, 0xa5, 0x2e, 0xae, 0x15, 0x5f,
+            0x05, 0x64, 0xf8, 0x79, 0xd2, 0x7a, 0xe3, 0xc0, 0x2c, 0xe8, 0x28, 0x34, 0xac, 0xfa, 0x8c, 0x79,
+            0x3a, 0x62, 0x9f, 0x2c, 0xa0, 0xde, 0x69, 0x19, 0x61, 0x0b, 0xe8, 0x2f, 0x41, 0x13, 0x26, 0xbe
+        });
+    }
+    {
+        randomize::engines::chacha20 engine{zero};
+        compare("ChaCha20 zero key (RFC 8439 A.1)", keystream(engine, 64), {
+            0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+            0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a, 0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
+            0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d, 0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
+            0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c, 0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86
+        });
+    }
+    
+    // The dispatched block kernel, used by generate_block, gives the same
+    // keystream as the draws one by one
+    {
+        rfc_key(key);
+        randomize::engines::chacha20 one_by_one{key, 7};
+        randomize::engines::chacha20 by_blocks{key, 7};
+        std::vector<std::uint64_t> expected(1000);
+        std::vector<std::uint64_t> actual(1000);
+        for (auto& word : expected) {
+            word = one_by_one();
+        }
+        actual[0] = by_blocks();
+        by_blocks.generate_block(actual.data() + 1, actual.size() - 1);
+        const auto same = actual == expected;
+        std::printf("%-44s %s\n", "ChaCha20 generate_block", same ? "ok" : "MISMATCH");
+        test::check(same, "ChaCha20 generate_block");
+    }
+    
+    return test::report();
+}
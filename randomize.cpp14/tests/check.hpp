@@ -0,0 +1,46 @@
+/**
+ * Shared by the tests: check reports a failed condition, and
+ * report prints the outcome and gives the exit status.
+ */
+
+#ifndef check_h
+#define check_h
+
+#include <cstdio>
+
+namespace test {
+    /**
+     * @return - the number of failed checks so far.
+     */
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+    
+    /**
+     * Report what failed, unless ok.
+     * @return - ok.
+     */
+    inline bool check(bool ok, const char* what) {
+        if (!ok) {
+            std::printf("FAILED: %s\n", what);
+            ++failures();
+        }
+        return ok;
+    }
+    
+    /**
+     * Print passed when every check passed.
+     * @return - the exit status of the test.
+     */
+    inline int report() {
+        if (failures() != 0) {
+            std::printf("%d checks failed\n", failures());
+            return 1;
+        }
+        std::puts("passed");
+        return 0;
+    }
+}
+
+#endif
@@ -0,0 +1,61 @@
+// Check that discard_fast skips the same outputs as discard: for
+// std::mt19937_64, whose state is jumped through its textual
+// representation past 25M outputs, from several positions in the current
+// block, and for the xoshiro engines, whose discard uses it.
+// g++ -std=c++14 -I.. discard_test.cpp -pthread
+
+#include <cstdint>
+#include <random>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    /**
+     * @return - whether discard_fast and discard leave the engine in
+     * the same state, and it then draws the same numbers.
+     */
+    template <typename Engine>
+    bool same_as_discard(Engine engine, unsigned long long n) {
+        auto expected = engine;
+        discard_fast(engine, n);
+        expected.discard(n);
+        return engine == expected && engine() == expected() && engine() == expected();
+    }
+    
+    /**
+     * @return - whether discard skips the same outputs as drawing them.
+     */
+    template <typename Engine>
+    bool same_as_draws(Engine engine, unsigned long long n) {
+        auto expected = engine;
+        engine.discard(n);
+        for (auto i = n; i != 0; --i) {
+            expected();
+        }
+        return engine == expected && engine() == expected();
+    }
+}
+
+int main() {
+    constexpr unsigned long long block = std::mt19937_64::state_size;
+    constexpr auto jump = 80000 * block;
+    // Outputs already drawn, and outputs skipped past whole blocks
+    const unsigned long long offsets[][2] = {{0, 0}, {1, 311}, {311, 1}, {312, 0}, {500, 311}};
+    for (const auto& offset : offsets) {
+        std::mt19937_64 engine{42};
+        engine.discard(offset[0]);
+        check(same_as_discard(engine, 1000), "mt19937_64, short discard");
+        check(same_as_discard(engine, jump + offset[1]), "mt19937_64, jump");
+    }
+    
+    for (unsigned long long n : {0, 1, 255, 256, 1000, 1 << 20}) {
+        check(same_as_draws(engines::xoshiro256starstar{7}, n), "xoshiro256starstar");
+        check(same_as_draws(engines::xoshiro256plus{7}, n), "xoshiro256plus");
+    }
+    
+    return test::report();
+}
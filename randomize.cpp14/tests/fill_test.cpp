@@ -0,0 +1,111 @@
+// Check randomize::fill: the iterators of std::vector, std::array and
+// std::string fill the same numbers as raw pointers, for sizes which are
+// not a multiple of the block, the other iterators go through a buffer,
+// the numbers are in [min, max], and nothing outside the range is written.
+// g++ -std=c++14 -I.. fill_test.cpp -pthread
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    constexpr std::size_t sizes[] = {0, 1, 2, 3, 255, 256, 257, 511, 512, 513, 1000, 2049, 4099};
+    
+    /**
+     * @return - the numbers filled through raw pointers, after seeding.
+     */
+    template <typename T>
+    std::vector<T> expected(std::size_t size, T min, T max) {
+        std::vector<T> v(size);
+        seed(42);
+        fill(v.data(), v.data() + size, min, max);
+        return v;
+    }
+    
+    /**
+     * @return - whether the numbers are in [min, max].
+     */
+    template <typename Container, typename T>
+    bool in_range(const Container& c, T min, T max) {
+        for (auto value : c) {
+            if (value < min || value > max) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * Fill the middle of a vector, between sentinels, with its iterators.
+     */
+    template <typename T>
+    void check_vector(T min, T max, T sentinel) {
+        for (auto size : sizes) {
+            std::vector<T> v(size + 2, sentinel);
+            seed(42);
+            fill(v.begin() + 1, v.end() - 1, min, max);
+            const auto reference = expected(size, min, max);
+            check(std::equal(reference.begin(), reference.end(), v.begin() + 1), "vector iterators, same numbers as pointers");
+            check(v.front() == sentinel && v.back() == sentinel, "vector iterators, nothing written outside");
+            check(in_range(reference, min, max), "pointers, in range");
+        }
+    }
+    
+    /**
+     * Fill containers whose iterators are not contiguous.
+     */
+    template <typename Container, typename T>
+    void check_buffered(T min, T max) {
+        for (auto size : sizes) {
+            Container c(size);
+            fill(c.begin(), c.end(), min, max);
+            check(in_range(c, min, max), "buffered iterators, in range");
+        }
+    }
+}
+
+int main() {
+    check(details::is_contiguous_iterator<std::vector<int>::iterator, int>::value, "vector is contiguous");
+    check(details::is_contiguous_iterator<std::vector<float>::const_iterator, float>::value == false, "const vector is not written");
+    check(details::is_contiguous_iterator<std::array<double, 7>::iterator, double>::value, "array is contiguous");
+    check(details::is_contiguous_iterator<std::string::iterator, char>::value, "string is contiguous");
+    check(details::is_contiguous_iterator<std::vector<double>::iterator, float>::value == false, "other value type");
+    check(details::is_contiguous_iterator<std::vector<bool>::iterator, bool>::value == false, "vector<bool>");
+    check(details::is_contiguous_iterator<std::deque<int>::iterator, int>::value == false, "deque");
+    
+    check_vector<int>(-5, 1000, 12345);
+    check_vector<float>(-1.f, 1.f, 7.f);
+    check_vector<double>(0., 1e6, -1.);
+    check_vector<std::uint64_t>(0, ~std::uint64_t{0} / 3, ~std::uint64_t{0});
+    check_vector<short>(1, 6, 0);
+    
+    std::array<double, 1001> a;
+    seed(42);
+    fill(a.begin(), a.end(), -3., 3.);
+    const auto reference = expected(a.size(), -3., 3.);
+    check(std::equal(reference.begin(), reference.end(), a.begin()), "array iterators, same numbers as pointers");
+    
+    std::string s(777, '\0');
+    seed(42);
+    fill(s.begin(), s.end(), 'a', 'z');
+    const auto letters = expected<char>(s.size(), 'a', 'z');
+    check(std::equal(letters.begin(), letters.end(), s.begin()), "string iterators, same numbers as pointers");
+    
+    check_buffered<std::deque<int>>(1, 6);
+    check_buffered<std::deque<float>>(2.f, 3.f);
+    check_buffered<std::list<double>>(-1., 1.);
+    check_buffered<std::vector<double>>(1, 6);
+    
+    return test::report();
+}
@@ -0,0 +1,84 @@
+// Check that the floating point draws stay below max: with the largest
+// canonical value, the multiply-add of (1, 1.5) rounds to 1.5, which
+// must be clamped to the value below it, one draw at a time, in the
+// bulk conversion of full blocks and the tail, and with the native
+// doubles of a dSFMT-like engine.
+// g++ -std=c++14 -I.. float_test.cpp -pthread
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    /**
+     * An engine whose words have every bit set, i.e. the maximal mantissa.
+     */
+    struct ones {
+        using result_type = std::uint64_t;
+        
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+        
+        result_type operator()() { return max(); }
+    };
+    
+    /**
+     * An engine producing the largest double in [1, 2) natively.
+     */
+    struct native_ones : ones {
+        static double close1_open2() { return std::nextafter(2.0, 1.0); }
+        
+        void fill_close1_open2(double* first, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                first[i] = close1_open2();
+            }
+        }
+    };
+    
+    /**
+     * @return - whether a draw and fills of several sizes, including
+     * full blocks and tails, stay below max.
+     */
+    template <typename T, typename Engine>
+    bool below_max(T min, T max) {
+        const details::uniform_real_distribution<T> distribution{min, max};
+        Engine engine;
+        if (!(distribution(engine) < max)) {
+            return false;
+        }
+        for (std::size_t size : {1, 7, 512, 1000, 1024, 2049}) {
+            std::vector<T> values(size);
+            distribution.fill(engine, values.data(), values.data() + size);
+            for (auto value : values) {
+                if (!(value < max)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    check(below_max<float, ones>(1.f, 1.5f), "float");
+    check(below_max<double, ones>(1.0, 1.5), "double");
+    check(below_max<double, native_ones>(1.0, 1.5), "native double");
+    check(below_max<float, ones>(-2.f, 3.f), "float, wide range");
+    check(below_max<double, ones>(-1e300, 1e300), "double, huge range");
+    
+    ones engine;
+    const details::uniform_real_distribution<float> floats{1.f, 1.5f};
+    check(floats(engine) == std::nextafter(1.5f, 1.f), "float, value below max");
+    const details::uniform_real_distribution<float> point{2.f, 2.f};
+    check(point(engine) == 2.f, "empty range");
+    
+    return test::report();
+}
@@ -0,0 +1,98 @@
+// Forks 64 children after the parent drew from every path, and checks
+// that their first draws all differ: the children must not share the
+// state of the engines, or of the distributions, of their parent.
+// g++ -std=c++14 -I.. fork_test.cpp -pthread
+
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <tuple>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    struct draws {
+        std::uint64_t integer;
+        float floats[4];
+        std::uint64_t pooled;
+    };
+    
+    draws first_draws() {
+        draws d{};
+        d.integer = randomize::rand<std::uint64_t>();
+        for (auto& f : d.floats) {
+            f = randomize::rand<float, 0, 1>();
+        }
+        for (int i = 0; i < 64; ++i) {
+            d.pooled = (d.pooled << 1) | static_cast<std::uint64_t>(randomize::rand<bool>(randomize::pooled));
+        }
+        return d;
+    }
+}
+
+int main() {
+    constexpr int children = 64;
+    
+    // The parent draws once from every path before forking, leaving
+    // e.g. 63 pooled draws in the word of rand<bool>(pooled)
+    (void)randomize::rand<std::uint64_t>();
+    (void)randomize::rand<float, 0, 1>();
+    (void)randomize::rand<bool>(randomize::pooled);
+    
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+    for (int i = 0; i < children; ++i) {
+        const auto pid = fork();
+        if (pid < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            const auto d = first_draws();
+            const auto written = write(fds[1], &d, sizeof(d));
+            _exit(written == static_cast<ssize_t>(sizeof(d)) ? 0 : 1);
+        }
+    }
+    close(fds[1]);
+    
+    std::set<std::uint64_t> integers;
+    std::set<std::tuple<float, float, float, float>> floats;
+    // Floats have 24 bits, so a few may collide by chance, but not most
+    std::set<float> nth_floats[4];
+    std::set<std::uint64_t> pooled;
+    draws d;
+    int received = 0;
+    while (read(fds[0], &d, sizeof(d)) == static_cast<ssize_t>(sizeof(d))) {
+        integers.insert(d.integer);
+        floats.insert(std::make_tuple(d.floats[0], d.floats[1], d.floats[2], d.floats[3]));
+        for (int i = 0; i < 4; ++i) {
+            nth_floats[i].insert(d.floats[i]);
+        }
+        pooled.insert(d.pooled);
+        ++received;
+    }
+    
+    for (int i = 0; i < children; ++i) {
+        int status = 0;
+        wait(&status);
+        test::check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "child exit status");
+    }
+    
+    std::printf("%d children: %zu distinct integers, %zu distinct floats, %zu distinct pooled draws\n",
+                received, integers.size(), floats.size(), pooled.size());
+    test::check(received == children, "draws of every child");
+    test::check(integers.size() == children, "distinct integers");
+    test::check(floats.size() == children, "distinct floats");
+    for (const auto& nth : nth_floats) {
+        test::check(nth.size() >= children / 2, "distinct nth floats");
+    }
+    test::check(pooled.size() == children, "distinct pooled draws");
+    return test::report();
+}
@@ -0,0 +1,167 @@
+// Check the pooled draws at the edges of the pool layout: a power of two
+// range whose bits divide 64 takes each bit of a word, e.g. 64 coin flips
+// or 8 bytes, and one which does not, like [0, 8), leaves the low bits of
+// the word; a range of 3 rejects some words; [0, 2^32] takes a word per draw;
+// the full 64 bits range gives the words themselves, and a single value
+// range does not reach the engine. The draws with bounds known at compile
+// time are those with bounds given at run time.
+// g++ -std=c++14 -I.. pooled_test.cpp -pthread
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    /**
+     * splitmix64 counting the words drawn from it.
+     */
+    struct counting {
+        using result_type = std::uint64_t;
+        
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+        
+        result_type operator()() {
+            ++calls;
+            return engine();
+        }
+        
+        engines::splitmix64 engine{42};
+        std::size_t calls = 0;
+    };
+    
+    /**
+     * @return - the first count draws of the distribution.
+     */
+    template <typename Distribution>
+    std::vector<typename Distribution::result_type> draws(Distribution distribution, counting& engine, std::size_t count) {
+        std::vector<typename Distribution::result_type> v(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            v[i] = distribution(engine);
+        }
+        return v;
+    }
+    
+    /**
+     * A range of 2^bits values whose bits divide 64 takes the bits
+     * of each word from the top, without rejecting any word.
+     */
+    template <typename T, T min, T max>
+    void check_power_of_two(unsigned bits, const char* name) {
+        const auto per_word = 64 / bits;
+        counting engine;
+        const auto v = draws(details::pooled_int_distribution<T>{min, max}, engine, 100 * per_word);
+        check(engine.calls == 100, name);
+        auto words = engines::splitmix64{42};
+        bool same = true;
+        for (std::size_t i = 0; i < v.size(); i += per_word) {
+            const auto word = words();
+            for (std::size_t j = 0; j < per_word; ++j) {
+                const auto expected = static_cast<std::uint64_t>(word << (j * bits)) >> (64 - bits);
+                same = same && static_cast<std::uint64_t>(v[i + j] - min) == expected;
+            }
+        }
+        check(same, name);
+        
+        counting static_engine;
+        check(draws(details::static_pooled_int_distribution<T, min, max>{}, static_engine, v.size()) == v, name);
+    }
+    
+    /**
+     * Draw a range with a large sample, in the range and close to
+     * uniform, and with the draws with static bounds the same.
+     * @return - the number of words drawn per draw.
+     */
+    template <typename T, T min, T max>
+    double check_range(std::size_t count, const char* name) {
+        counting engine;
+        const auto v = draws(details::pooled_int_distribution<T>{min, max}, engine, count);
+        const auto range = details::range_width(min, max);
+        const auto buckets = range < 16 ? range : 16;
+        std::vector<std::size_t> hits(buckets);
+        bool in_range = true;
+        for (const auto value : v) {
+            in_range = in_range && value >= min && value <= max;
+            ++hits[static_cast<std::uint64_t>(value - min) / ((range - 1) / buckets + 1)];
+        }
+        check(in_range, name);
+        // Within 5% of the count expected in each bucket, the last one
+        // being smaller for [0, 2^32]
+        bool uniform = true;
+        for (std::size_t b = 0; b + 1 < buckets; ++b) {
+            const auto expected = static_cast<double>(count) / static_cast<double>(buckets);
+            uniform = uniform && hits[b] > 0.95 * expected && hits[b] < 1.05 * expected;
+        }
+        check(uniform, name);
+        
+        counting static_engine;
+        check(draws(details::static_pooled_int_distribution<T, min, max>{}, static_engine, count) == v, name);
+        return static_cast<double>(engine.calls) / static_cast<double>(count);
+    }
+}
+
+int main() {
+    check_power_of_two<bool, false, true>(1, "coins");
+    check_power_of_two<int, 0, 3>(2, "range 4");
+    check_power_of_two<int, -8, 7>(4, "range 16");
+    check_power_of_two<std::uint8_t, 0, 255>(8, "bytes");
+    check_power_of_two<std::int8_t, -128, 127>(8, "signed bytes");
+    check_power_of_two<std::uint16_t, 0, 65535>(16, "range 2^16");
+    check_power_of_two<std::uint64_t, 0, 0xffffffff>(32, "range 2^32");
+    
+    // 2^63 is the largest power of 8 in a word: 21 draws, the low bit unused
+    const auto eights = details::make_pool_layout(8);
+    check(eights.count == 21 && eights.threshold == 0, "range 8 layout");
+    check(check_range<int, 0, 7>(21 * 1000, "range 8") == 1. / 21, "range 8 words");
+    
+    const auto threes = details::make_pool_layout(3);
+    check(threes.count > 1 && threes.threshold != 0, "range 3 layout");
+    const auto three_words = check_range<int, 1, 3>(1000000, "range 3");
+    check(three_words > 1. / threes.count && three_words < 1.1 / threes.count, "range 3 words");
+    
+    const auto wide = details::make_pool_layout(std::uint64_t{1} << 32 | 1);
+    check(wide.count == 1 && wide.product == (std::uint64_t{1} << 32 | 1), "range 2^32 + 1 layout");
+    const auto wide_words = check_range<std::uint64_t, 0, std::uint64_t{1} << 32>(100000, "range 2^32 + 1");
+    check(wide_words >= 1. && wide_words < 1.001, "range 2^32 + 1 words");
+    
+    counting full;
+    const auto words = draws(details::pooled_int_distribution<std::uint64_t>{0, std::numeric_limits<std::uint64_t>::max()}, full, 1000);
+    counting signed_full;
+    const auto signed_words = draws(details::pooled_int_distribution<std::int64_t>{std::numeric_limits<std::int64_t>::min(),
+                                                                                  std::numeric_limits<std::int64_t>::max()}, signed_full, 1000);
+    auto expected = engines::splitmix64{42};
+    bool same = true;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const auto word = expected();
+        same = same && words[i] == word && static_cast<std::uint64_t>(signed_words[i]) == word;
+    }
+    check(same && full.calls == 1000 && signed_full.calls == 1000, "full 64 bits range");
+    counting static_full;
+    check(draws(details::static_pooled_int_distribution<std::uint64_t, 0, std::numeric_limits<std::uint64_t>::max()>{}, static_full, 1000) == words,
+          "full 64 bits range, static bounds");
+    
+    counting single;
+    const auto sevens = draws(details::pooled_int_distribution<int>{7, 7}, single, 1000);
+    counting static_single;
+    const auto static_sevens = draws(details::static_pooled_int_distribution<int, 7, 7>{}, static_single, 1000);
+    check(sevens == std::vector<int>(1000, 7) && static_sevens == sevens, "single value");
+    check(single.calls == 0 && static_single.calls == 0, "single value, no engine call");
+    
+    auto dice = get_rand(pooled, 1, 6);
+    bool dice_in_range = true;
+    for (int i = 0; i < 100000; ++i) {
+        const auto value = dice();
+        const auto static_value = rand<int, 1, 6>(pooled);
+        dice_in_range = dice_in_range && value >= 1 && value <= 6 && static_value >= 1 && static_value <= 6;
+    }
+    check(dice_in_range, "get_rand and rand, pooled dice");
+    
+    return test::report();
+}
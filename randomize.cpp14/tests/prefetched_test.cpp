@@ -0,0 +1,67 @@
+// Check engines::prefetched: get_rand from a seed tree node owns a
+// prefetched engine, which draws the same numbers as the engine itself,
+// a parallel fill with it draws its chunks from the buffered engine, and
+// a child forked while the prefetch thread waits for a ring can
+// still prefetch.
+// g++ -std=c++14 -I.. prefetched_test.cpp -pthread
+
+#include <cstdint>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    /**
+     * @return - whether the prefetched generator of a node draws the
+     * same numbers as the generator of the engine itself.
+     */
+    template <typename Engine>
+    bool same_draws(const seed_tree& node) {
+        auto prefetched = get_rand<int, engines::prefetched<Engine>>(node, 1, 1000);
+        auto plain = get_rand<int, Engine>(node, 1, 1000);
+        auto moved = std::move(prefetched);
+        for (int i = 0; i < 100000; ++i) {
+            if (moved() != plain()) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    const auto node = seed_tree{42}.child("prefetched");
+    check(same_draws<engines::xoshiro256plus>(node), "seed tree, xoshiro256plus");
+    check(same_draws<engines::philox4x32>(node), "seed tree, philox4x32");
+    
+    std::vector<double> prefetched(5 * details::parallel_chunk_size / 2);
+    std::vector<double> buffered(prefetched.size());
+    fill<double, engines::prefetched<engines::xoshiro256plus>>(par.seed(42).threads(2), prefetched, 0., 1.);
+    fill<double, engines::buffered<engines::xoshiro256plus>>(par.seed(42).threads(2), buffered, 0., 1.);
+    check(prefetched == buffered, "parallel fill");
+    
+    // All the rings are closed: the thread waits for the next one
+    usleep(20000);
+    const auto pid = fork();
+    if (pid == 0) {
+        auto prefetched = engines::prefetched<engines::xoshiro256plus>{7};
+        auto plain = engines::xoshiro256plus{7};
+        for (int i = 0; i < 100000; ++i) {
+            if (prefetched() != plain()) {
+                _exit(1);
+            }
+        }
+        _exit(0);
+    }
+    int status = 0;
+    check(pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "fork");
+    
+    return test::report();
+}
@@ -0,0 +1,72 @@
+// Check the keys of the get_rand cache: they are the bit patterns of
+// (min, max), without the padding of long double, so that -0.0 and 0.0
+// make different entries, the float ranges of a unit interval spread
+// across the shards, and get_rand draws in range while its cache evicts.
+// g++ -std=c++14 -I.. range_key_test.cpp -pthread
+
+#define RANDOMIZE_GET_RAND_CAPACITY 256
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    template <typename T>
+    bool same_key(const details::range_key<T>& a, const details::range_key<T>& b) {
+        return std::equal(std::begin(a.words), std::end(a.words), std::begin(b.words)) && a.hash() == b.hash();
+    }
+    
+    void check_keys() {
+        check(!same_key(details::range_key<double>{-0.0, 1.0}, details::range_key<double>{0.0, 1.0}), "-0.0 and 0.0");
+        check(!same_key(details::range_key<float>{0.f, 1.f}, details::range_key<float>{1.f, 0.f}), "min and max");
+        check(same_key(details::range_key<long double>{1.5L, 2}, details::range_key<long double>{1.5L, 2}), "long double");
+        
+        // Ranges which used to hash the same
+        constexpr int ranges = 10000;
+        std::set<std::uint64_t> hashes;
+        std::vector<int> shards(64);
+        for (int i = 0; i < ranges; ++i) {
+            const auto min = static_cast<float>(i) / ranges;
+            const auto hash = details::range_key<float>{min, min + 1e-3f}.hash();
+            hashes.insert(hash);
+            ++shards[hash % shards.size()];
+        }
+        check(hashes.size() == ranges, "float ranges, distinct hashes");
+        const auto spread = std::minmax_element(shards.begin(), shards.end());
+        check(*spread.first > ranges / 64 / 2 && *spread.second < ranges / 64 * 2, "float ranges, shards");
+    }
+    
+    void check_get_rand() {
+        const auto before = get_rand_statistics<double>();
+        get_rand(0.0, 1.0)();
+        get_rand(0.0, 1.0)();
+        get_rand(-0.0, 1.0)();
+        const auto after = get_rand_statistics<double>();
+        check(after.misses - before.misses == 2 && after.hits - before.hits == 1, "get_rand, -0.0 and 0.0");
+        
+        bool in_range = true;
+        for (int i = 0; i < 10000; ++i) {
+            const auto min = static_cast<float>(i) / 10000;
+            const auto value = get_rand(min, min + 1e-3f)();
+            in_range &= value >= min && value < min + 1e-3f;
+            const auto n = get_rand(i, 2 * i + 7)();
+            in_range &= n >= i && n <= 2 * i + 7;
+        }
+        check(in_range, "get_rand, in range");
+        const auto floats = get_rand_statistics<float>();
+        check(floats.evictions > 0 && floats.size <= floats.capacity && floats.capacity == 256, "get_rand, bounded");
+    }
+}
+
+int main() {
+    check_keys();
+    check_get_rand();
+    return test::report();
+}
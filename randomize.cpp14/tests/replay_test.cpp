@@ -0,0 +1,59 @@
+// Checks that the draws of every path are replayed, by RANDOMIZE_SEED
+// and by seed(), whatever was drawn before.
+// g++ -std=c++14 -I.. replay_test.cpp -pthread
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    std::vector<double> draws() {
+        std::vector<double> v;
+        v.push_back(randomize::rand(1, 6));
+        v.push_back(randomize::rand<std::uint64_t>() >> 11);
+        v.push_back(randomize::rand<int, 1, 6>());
+        v.push_back(randomize::rand(0.f, 1.f));
+        v.push_back(randomize::rand<float, 0, 1>());
+        v.push_back(randomize::rand<double, -2, 3>());
+        auto f = randomize::get_rand(0.f, 1.f);
+        v.push_back(f());
+        v.push_back(f());
+        auto dice = randomize::get_rand(randomize::pooled, 1, 6);
+        v.push_back(dice());
+        v.push_back(dice());
+        v.push_back(randomize::rand<int, 1, 6>(randomize::pooled));
+        v.push_back(randomize::rand<bool>(randomize::pooled));
+        std::vector<float> w(100);
+        randomize::fill(w, -1.f, 1.f);
+        v.insert(v.end(), w.begin(), w.end());
+        return v;
+    }
+}
+
+int main() {
+    // Before the key is created, i.e. before the first draw
+    setenv("RANDOMIZE_SEED", "7", 1);
+    const auto from_environment = draws();
+    
+    randomize::seed(7);
+    const auto from_seed = draws();
+    
+    // An odd number of draws from every path, which must not be carried over
+    (void)draws();
+    (void)randomize::rand<float, 0, 1>();
+    (void)randomize::rand<int, 1, 6>(randomize::pooled);
+    randomize::seed(7);
+    const auto replayed = draws();
+    
+    randomize::seed(8);
+    const auto other = draws();
+    
+    test::check(from_environment == from_seed, "RANDOMIZE_SEED=7 replays seed(7)");
+    test::check(from_seed == replayed, "seed(7) replays seed(7)");
+    test::check(other != replayed, "seed(8) differs from seed(7)");
+    return test::report();
+}
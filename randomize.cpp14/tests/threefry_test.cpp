@@ -0,0 +1,87 @@
+// Check threefry4x64: operator== compares the whole state, including
+// the third and fourth key words which only a seed sequence sets, and
+// discard and generate_block give the outputs of the draws one by one.
+// g++ -std=c++14 -I.. threefry_test.cpp -pthread
+
+#include <cstdint>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    using test::check;
+    
+    /**
+     * A seed sequence which generates the given key words.
+     */
+    struct key_sequence {
+        using result_type = std::uint32_t;
+        
+        std::uint64_t key[4];
+        
+        template <typename It>
+        void generate(It first, It last) const {
+            for (std::size_t i = 0; first != last; ++first, ++i) {
+                *first = static_cast<std::uint32_t>(key[i / 2 % 4] >> (32 * (i % 2)));
+            }
+        }
+    };
+    
+    /**
+     * @return - the next count outputs, drawn one by one.
+     */
+    std::vector<std::uint64_t> draws(engines::threefry4x64 engine, std::size_t count) {
+        std::vector<std::uint64_t> v(count);
+        for (auto& word : v) {
+            word = engine();
+        }
+        return v;
+    }
+}
+
+int main() {
+    auto a = engines::threefry4x64{1, 2};
+    auto b = engines::threefry4x64{1, 3};
+    auto c = engines::threefry4x64{4, 2};
+    check(a != b && b != a, "streams differ");
+    check(a != c && c != a, "seeds differ");
+    
+    auto copy = a;
+    check(copy == a, "copy");
+    const auto first = a();
+    check(first != b() && first != c(), "first outputs");
+    check(copy != a, "one draw ahead");
+    check(first == copy() && copy == a, "same draws");
+    
+    key_sequence keys[] = {
+        {{1, 2, 3, 4}},
+        {{1, 2, 3, 5}},
+        {{1, 2, 6, 4}},
+    };
+    auto d = engines::threefry4x64{keys[0]};
+    auto e = engines::threefry4x64{keys[1]};
+    auto f = engines::threefry4x64{keys[2]};
+    check(d != e && e != d, "key words 3 differ");
+    check(d != f && f != d, "key words 2 differ");
+    const auto word = d();
+    check(word != e() && word != f(), "key words differ, outputs differ");
+    
+    for (std::size_t skip : {0, 1, 3, 4, 5, 17, 1000}) {
+        const auto expected = draws(a, skip + 1);
+        auto skipped = a;
+        skipped.discard(skip);
+        check(skipped() == expected.back(), "discard");
+    }
+    
+    for (std::size_t count : {1, 3, 4, 15, 16, 17, 100}) {
+        const auto expected = draws(a, count);
+        std::vector<std::uint64_t> block(count);
+        auto blocks = a;
+        blocks.generate_block(block.data(), count);
+        check(block == expected, "generate_block");
+    }
+    
+    return test::report();
+}
@@ -0,0 +1,128 @@
+// Check the SIMD lanes of xoshiro256plus_lanes<N> against the scalar
+// xoshiro256plus: lane l must produce the stream of xoshiro256plus{seed}
+// jumped l times. The kernel of every dispatch target supported by the
+// CPU (generic, AVX2, AVX-512) is run on its own, and generate_block is
+// run with blocks smaller than, equal to and not a multiple of the lane
+// count. Build also with -DRANDOMIZE_NO_DISPATCH to check generate_block
+// on the generic path.
+// g++ -std=c++14 -I.. xoshiro_lanes_test.cpp -pthread
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "check.hpp"
+#include "randomize.hpp"
+
+namespace {
+    using namespace randomize;
+    
+    using kernel = void (*)(std::uint64_t*, std::uint64_t*, std::size_t);
+    
+    constexpr std::uint64_t seed = 42;
+    
+    /**
+     * @return - the first steps * Lanes outputs of the scalar lanes,
+     * interleaved as xoshiro256plus_lanes<Lanes> outputs them.
+     */
+    template <std::size_t Lanes>
+    std::vector<std::uint64_t> reference(std::size_t steps) {
+        std::vector<engines::xoshiro256plus> lanes;
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            lanes.emplace_back(seed);
+            for (std::size_t jumps = 0; jumps < l; ++jumps) {
+                lanes.back().jump();
+            }
+        }
+        std::vector<std::uint64_t> expected;
+        for (std::size_t step = 0; step < steps; ++step) {
+            for (auto& lane : lanes) {
+                expected.push_back(lane());
+            }
+        }
+        return expected;
+    }
+    
+    /**
+     * Run a kernel from the seeded state, a few steps at a time.
+     */
+    template <std::size_t Lanes>
+    void check_kernel(kernel run, const char* name, const std::vector<std::uint64_t>& expected) {
+        std::uint64_t lane[4];
+        auto seeder = engines::splitmix64{seed};
+        for (auto& word : lane) {
+            word = seeder();
+        }
+        std::uint64_t state[4 * Lanes];
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            if (l != 0) {
+                details::xoshiro256_jump(lane, details::xoshiro256_jump_polynomial);
+            }
+            for (std::size_t i = 0; i < 4; ++i) {
+                state[i * Lanes + l] = lane[i];
+            }
+        }
+        std::vector<std::uint64_t> output(expected.size());
+        std::size_t done = 0;
+        for (std::size_t steps : {0, 1, 2, 3, 5, 17, 100}) {
+            run(state, output.data() + done * Lanes, steps);
+            done += steps;
+        }
+        run(state, output.data() + done * Lanes, expected.size() / Lanes - done);
+        test::check(output == expected, name);
+    }
+    
+    /**
+     * Draw from the engine with generate_block in blocks of awkward
+     * sizes, with single draws in between so that blocks also start in
+     * the middle of a step.
+     */
+    template <std::size_t Lanes>
+    void check_generate_block(const std::vector<std::uint64_t>& expected) {
+        auto engine = engines::xoshiro256plus_lanes<Lanes>{seed};
+        std::vector<std::uint64_t> output(expected.size());
+        std::size_t done = 0;
+        const std::size_t blocks[] = {0, 1, Lanes - 1, Lanes, Lanes + 1, 2 * Lanes - 1, 3 * Lanes + 3, 10 * Lanes, 7};
+        for (int round = 0; round < 3; ++round) {
+            for (auto count : blocks) {
+                engine.generate_block(output.data() + done, count);
+                done += count;
+                output[done++] = engine();
+            }
+        }
+        engine.generate_block(output.data() + done, output.size() - done);
+        test::check(output == expected, "generate_block");
+    }
+    
+    template <std::size_t Lanes>
+    void check_lanes() {
+        const auto expected = reference<Lanes>(200);
+        check_kernel<Lanes>(details::xoshiro256plus_lanes_generic<Lanes>, "generic kernel", expected);
+        #if defined(RANDOMIZE_X86_DISPATCH)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                check_kernel<Lanes>(details::xoshiro256plus_lanes_avx2<Lanes>, "avx2 kernel", expected);
+            } else {
+                std::printf("avx2 not supported, skipped\n");
+            }
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+                check_kernel<Lanes>(details::xoshiro256plus_lanes_avx512<Lanes>, "avx512 kernel", expected);
+            } else {
+                std::printf("avx512 not supported, skipped\n");
+            }
+        #endif
+        check_kernel<Lanes>(details::xoshiro256plus_lanes<Lanes>, "dispatched kernel", expected);
+        check_generate_block<Lanes>(expected);
+    }
+}
+
+int main() {
+    std::printf("4 lanes\n");
+    check_lanes<4>();
+    std::printf("8 lanes\n");
+    check_lanes<8>();
+    std::printf("16 lanes\n");
+    check_lanes<16>();
+    return test::report();
+}